@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace wm::bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @struct Benchmark
+	 * @brief A named benchmark that prints its own result table.
+	 */
+	struct Benchmark
+	{
+		std::string name;
+		std::string description;
+		std::function<void()> run;
+	};
+
+	/**
+	 * @brief Gets every benchmark registered so far, in registration order.
+	 *
+	 * @return The registry.
+	 */
+	std::vector<Benchmark> &registry();
+
+	/**
+	 * @struct Registration
+	 * @brief Adds a benchmark to the registry from a static initializer.
+	 */
+	struct Registration
+	{
+		Registration(std::string name, std::string description, std::function<void()> run)
+		{
+			registry().push_back({std::move(name), std::move(description), std::move(run)});
+		}
+	};
+
+	/**
+	 * @struct SyscallCounters
+	 * @brief System call and scheduler counters of the process or of one thread.
+	 *
+	 * rw_calls comes from syscr + syscw in /proc io accounting, which counts the
+	 * read and write families (read, readv, write, writev, eventfd) but not
+	 * epoll_wait, poll, futex or io_uring_enter, nor I/O done by io_uring itself.
+	 * Those calls almost always block, so they show up as context switches.
+	 */
+	struct SyscallCounters
+	{
+		uint64_t rw_calls = 0;
+		uint64_t context_switches = 0;
+
+		/**
+		 * @brief Reads the counters of the whole process, finished threads included.
+		 *
+		 * @return The counters.
+		 */
+		static SyscallCounters process();
+
+		/**
+		 * @brief Reads the counters of the calling thread.
+		 *
+		 * @return The counters.
+		 */
+		static SyscallCounters thread();
+
+		SyscallCounters operator-(const SyscallCounters &other) const
+		{
+			return {rw_calls - other.rw_calls, context_switches - other.context_switches};
+		}
+	};
+
+	/**
+	 * @brief Keeps the compiler from optimizing a computed value away.
+	 *
+	 * @param value The value to keep.
+	 */
+	template <typename T>
+	inline void keep(const T &value)
+	{
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	/**
+	 * @brief Times body() and returns the fastest of several runs.
+	 *
+	 * @param body The code to time.
+	 * @param runs Number of timed runs after one warm-up run.
+	 *
+	 * @return Seconds taken by the fastest run.
+	 */
+	template <typename F>
+	double best_of(F &&body, int runs = 5)
+	{
+		body();
+		double best = 1e30;
+		for (int i = 0; i < runs; ++i)
+		{
+			auto start = Clock::now();
+			body();
+			best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+		}
+		return best;
+	}
+
+	/**
+	 * @brief Prints a section heading.
+	 *
+	 * @param title The heading.
+	 */
+	void print_heading(const std::string &title);
+}
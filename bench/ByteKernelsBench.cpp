@@ -0,0 +1,98 @@
+#include "Bench.hpp"
+
+#include "protocols/ByteKernels.hpp"
+
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+using namespace wm::protoc;
+
+namespace wm::bench
+{
+	namespace
+	{
+		constexpr size_t BYTES_PER_RUN = size_t(64) << 20;
+		/// Instruction sets are measured in turn this many times, so a slow phase of the machine hits all of them.
+		constexpr int ROUNDS = 5;
+		constexpr const char *ISAS[] = {"scalar", "avx2", "avx512vbmi"};
+
+		/// Runs kernel over a size-byte buffer until BYTES_PER_RUN bytes were processed and returns GB/s.
+		template <typename F>
+		double gigabytes_per_second(size_t size, F &&kernel)
+		{
+			std::vector<char> src(size);
+			std::vector<char> dst(size);
+			for (size_t i = 0; i < size; ++i)
+			{
+				src[i] = static_cast<char>(i * 131 + 7);
+			}
+
+			size_t repeats = std::max<size_t>(1, BYTES_PER_RUN / size);
+			double seconds = best_of([&]
+									 {
+				for (size_t i = 0; i < repeats; ++i)
+				{
+					kernel(src.data(), dst.data(), size);
+					keep(dst[0]);
+				} }, 3);
+			return static_cast<double>(repeats * size) / seconds / 1e9;
+		}
+
+		ByteTable shuffled_table()
+		{
+			ByteTable table;
+			for (size_t i = 0; i < table.size(); ++i)
+			{
+				// 167 is odd, so this is a permutation of the byte values.
+				table[i] = static_cast<uint8_t>(i * 167 + 13);
+			}
+			return table;
+		}
+
+		void run()
+		{
+			const std::string detected = byte_kernels_isa();
+			const SubstitutionTable table(shuffled_table());
+
+			std::printf("Detected: %s. The scalar row is the plain byte loop as compiled with -O3.\n", detected.c_str());
+			std::printf("add_bytes runs that loop on every row, so its column shows the run-to-run noise.\n\n");
+			std::printf("%-11s %9s %12s %12s %16s %16s\n", "isa", "size", "add GB/s", "add x scalar",
+						"substitute GB/s", "substitute x sc.");
+
+			for (size_t size : {size_t(250), size_t(1) << 20})
+			{
+				double add[std::size(ISAS)] = {};
+				double substitute[std::size(ISAS)] = {};
+				for (int round = 0; round < ROUNDS; ++round)
+				{
+					for (size_t i = 0; i < std::size(ISAS); ++i)
+					{
+						if (!set_byte_kernels_isa(ISAS[i]))
+						{
+							continue;
+						}
+
+						add[i] = std::max(add[i], gigabytes_per_second(size, [](const char *src, char *dst, size_t count)
+																	   { add_bytes(src, dst, count, 0x69); }));
+						substitute[i] = std::max(substitute[i], gigabytes_per_second(size, [&table](const char *src, char *dst, size_t count)
+																					 { substitute_bytes(src, dst, count, table); }));
+					}
+				}
+
+				for (size_t i = 0; i < std::size(ISAS); ++i)
+				{
+					if (add[i] > 0)
+					{
+						std::printf("%-11s %9zu %12.2f %12.2f %16.2f %16.2f\n", ISAS[i], size, add[i], add[i] / add[0],
+									substitute[i], substitute[i] / substitute[0]);
+					}
+				}
+			}
+
+			set_byte_kernels_isa(detected.c_str());
+		}
+
+		const Registration registration("bytes", "add_bytes and substitute_bytes per instruction set", run);
+	}
+}
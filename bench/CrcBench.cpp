@@ -0,0 +1,74 @@
+#include "Bench.hpp"
+
+#include "protocols/Crc.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace wm::protoc;
+
+namespace wm::bench
+{
+	namespace
+	{
+		constexpr size_t FRAME_SIZE = 255;
+		constexpr size_t FRAME_COUNT = 256;
+		constexpr size_t PASSES = 400;
+		/// 921600 baud with 8N1 framing moves 10 bits per byte.
+		constexpr double BYTES_PER_SECOND_AT_921600 = 921600.0 / 10;
+
+		/// Checksums every frame PASSES times and returns nanoseconds per frame.
+		template <typename F>
+		double ns_per_frame(const std::vector<char> &frames, F &&checksum)
+		{
+			double seconds = best_of([&]
+									 {
+				for (size_t pass = 0; pass < PASSES; ++pass)
+				{
+					for (size_t offset = 0; offset < frames.size(); offset += FRAME_SIZE)
+					{
+						keep(checksum(frames.data() + offset, FRAME_SIZE));
+					}
+				} });
+			return seconds * 1e9 / static_cast<double>(PASSES * FRAME_COUNT);
+		}
+
+		void print_row(const char *name, double ns)
+		{
+			double frames_per_second = BYTES_PER_SECOND_AT_921600 / FRAME_SIZE;
+			std::printf("%-20s %10.1f %10.2f %16.4f\n", name, ns, FRAME_SIZE / ns, ns * frames_per_second / 1e9 * 100);
+		}
+
+		void run()
+		{
+			std::vector<char> frames(FRAME_SIZE * FRAME_COUNT);
+			for (size_t i = 0; i < frames.size(); ++i)
+			{
+				frames[i] = static_cast<char>(i * 131 + 7);
+			}
+
+			const std::string detected = crc32c_isa();
+			std::printf("%zu different %zu-byte frames, best of 5. The last column is the share of one\n", FRAME_COUNT, FRAME_SIZE);
+			std::printf("CPU spent checksumming a port saturated at 921600 baud (8N1).\n\n");
+			std::printf("%-20s %10s %10s %16s\n", "checksum", "ns/frame", "GB/s", "% CPU @921600");
+
+			print_row("crc16_ccitt", ns_per_frame(frames, [](const char *data, size_t size)
+												 { return crc16_ccitt(data, size); }));
+
+			for (const char *isa : {"slice-by-8", "sse4.2"})
+			{
+				if (!set_crc32c_isa(isa))
+				{
+					std::printf("crc32c %-13s not supported by this CPU\n", isa);
+					continue;
+				}
+				print_row(("crc32c " + std::string(isa)).c_str(), ns_per_frame(frames, [](const char *data, size_t size)
+																				 { return crc32c(data, size); }));
+			}
+
+			set_crc32c_isa(detected.c_str());
+		}
+
+		const Registration registration("crc", "crc16_ccitt and crc32c on 255-byte frames", run);
+	}
+}
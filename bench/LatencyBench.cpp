@@ -0,0 +1,138 @@
+#include "Bench.hpp"
+
+#include "transport/PtyTransport.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace wm::transport;
+using namespace wm::messages;
+
+namespace wm::bench
+{
+	namespace
+	{
+		constexpr size_t ROUND_TRIPS = 2000;
+		constexpr size_t PAYLOAD_SIZE = 16;
+		constexpr auto REPLY_TIMEOUT = std::chrono::milliseconds(500);
+
+		/// Plays the remote device: writes every byte read from the master side straight back.
+		void echo(int fd, const std::atomic<bool> &stop)
+		{
+			char buffer[512];
+			struct pollfd pfd{fd, POLLIN, 0};
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				if (::poll(&pfd, 1, 50) <= 0)
+				{
+					continue;
+				}
+
+				ssize_t count = ::read(fd, buffer, sizeof(buffer));
+				if (count <= 0)
+				{
+					break;
+				}
+				for (ssize_t offset = 0; offset < count;)
+				{
+					ssize_t written = ::write(fd, buffer + offset, static_cast<size_t>(count - offset));
+					if (written <= 0)
+					{
+						return;
+					}
+					offset += written;
+				}
+			}
+		}
+
+		/// Sends a frame, waits for the echoed frame to reach a subscriber, and returns every round trip in microseconds.
+		std::vector<double> round_trips(LatencyProfile profile)
+		{
+			SerialConfig config;
+			config.latency_profile = profile;
+			PtyTransport transport(config);
+
+			std::mutex mutex;
+			std::condition_variable replied;
+			uint64_t replies = 0;
+			auto subscription = transport.subscribeReceive([&](const MessageView &)
+														   {
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					++replies;
+				}
+				replied.notify_one(); });
+
+			if (transport.open() != ErrorCode::Success)
+			{
+				throw std::runtime_error("Failed to open " + transport.slaveName());
+			}
+
+			std::atomic<bool> stop{false};
+			std::thread peer(echo, transport.peerFd(), std::cref(stop));
+
+			std::vector<char> payload(PAYLOAD_SIZE, 'x');
+			auto message = Message(1, MessageType::Data, payload).serialize();
+			std::vector<double> samples;
+			samples.reserve(ROUND_TRIPS);
+
+			for (uint64_t i = 0; i < ROUND_TRIPS; ++i)
+			{
+				auto start = Clock::now();
+				transport.send(message.data(), message.size());
+
+				std::unique_lock<std::mutex> lock(mutex);
+				if (!replied.wait_for(lock, REPLY_TIMEOUT, [&]
+									  { return replies > i; }))
+				{
+					break;
+				}
+				samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+			}
+
+			stop = true;
+			peer.join();
+			transport.close();
+			return samples;
+		}
+
+		double percentile(std::vector<double> &samples, double fraction)
+		{
+			if (samples.empty())
+			{
+				return 0;
+			}
+			size_t index = std::min(samples.size() - 1, static_cast<size_t>(fraction * static_cast<double>(samples.size())));
+			std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+			return samples[index];
+		}
+
+		void run()
+		{
+			std::printf("%zu request/response round trips of %zu payload bytes over PtyTransport\n", ROUND_TRIPS, PAYLOAD_SIZE);
+			std::printf("A pty has no ASYNC_LOW_LATENCY flag or USB latency timer, so only the\n");
+			std::printf("transport's own path is measured; run against a USB adapter for the driver effect.\n\n");
+			std::printf("%-12s %8s %10s %10s %10s\n", "profile", "replies", "p50 us", "p99 us", "max us");
+
+			const std::pair<LatencyProfile, const char *> profiles[] = {
+				{LatencyProfile::Throughput, "Throughput"},
+				{LatencyProfile::Balanced, "Balanced"},
+				{LatencyProfile::LowLatency, "LowLatency"},
+			};
+
+			for (const auto &[profile, name] : profiles)
+			{
+				auto samples = round_trips(profile);
+				std::printf("%-12s %8zu %10.1f %10.1f %10.1f\n", name, samples.size(), percentile(samples, 0.5),
+							percentile(samples, 0.99), percentile(samples, 1.0));
+			}
+		}
+
+		const Registration registration("latency", "Round trip over PtyTransport for each LatencyProfile", run);
+	}
+}
@@ -0,0 +1,100 @@
+#include "Bench.hpp"
+
+#include "messages/Message.hpp"
+#include "transport/SpscQueue.hpp"
+
+#include <cstdio>
+
+using namespace wm::messages;
+using wm::transport::SpscQueue;
+
+namespace wm::bench
+{
+	namespace
+	{
+		constexpr size_t MESSAGE_COUNT = 200000;
+		constexpr size_t QUEUE_CAPACITY = 256;
+
+		/**
+		 * @struct HeapMessage
+		 * @brief The Message layout before inline payloads: the payload lived in a std::vector.
+		 */
+		struct HeapMessage
+		{
+			uint8_t len = 0;
+			uint32_t idx = 0;
+			MessageType mesType = MessageType::Undefined;
+			std::vector<char> data;
+			transport::Timestamp rx_timestamp = 0;
+
+			HeapMessage() = default;
+
+			HeapMessage(uint32_t index, MessageType type, const std::vector<char> &payload)
+				: idx(index), mesType(type), data(payload)
+			{
+				len = static_cast<uint8_t>(sizeof(idx) + sizeof(mesType) + data.size());
+			}
+		};
+
+		/// Builds MESSAGE_COUNT messages and keeps each one alive until the next replaces it.
+		template <typename M>
+		double construct(const std::vector<char> &payload)
+		{
+			return best_of([&payload]
+						   {
+				for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+				{
+					M message(static_cast<uint32_t>(i), MessageType::Data, payload);
+					keep(message);
+				} });
+		}
+
+		/**
+		 * Builds messages, queues them a queue-full at a time and pops them again on
+		 * the same thread, the way UartTransport hands frames to its dispatch thread.
+		 */
+		template <typename M>
+		double queue(const std::vector<char> &payload)
+		{
+			SpscQueue<M> messages(QUEUE_CAPACITY);
+			return best_of([&]
+						   {
+				for (size_t i = 0; i < MESSAGE_COUNT; i += QUEUE_CAPACITY)
+				{
+					for (size_t j = 0; j < QUEUE_CAPACITY; ++j)
+					{
+						messages.tryPush(M(static_cast<uint32_t>(i + j), MessageType::Data, payload));
+					}
+					messages.popBatch([](const M &message)
+									  { keep(message.len); }, QUEUE_CAPACITY);
+				} });
+		}
+
+		double ns_per_message(double seconds)
+		{
+			return seconds * 1e9 / static_cast<double>(MESSAGE_COUNT);
+		}
+
+		void run()
+		{
+			std::printf("sizeof(Message) = %zu, sizeof(HeapMessage) = %zu (+ heap block per payload)\n",
+						sizeof(Message), sizeof(HeapMessage));
+			std::printf("%zu messages, best of 5; queue cycles %zu messages through SpscQueue\n\n",
+						MESSAGE_COUNT, QUEUE_CAPACITY);
+			std::printf("%-8s %16s %16s %16s %16s\n", "payload", "heap ctor ns", "inline ctor ns",
+						"heap queue ns", "inline queue ns");
+
+			for (size_t size : {8, 64, 249})
+			{
+				std::vector<char> payload(size, 'x');
+				std::printf("%-8zu %16.1f %16.1f %16.1f %16.1f\n", size,
+							ns_per_message(construct<HeapMessage>(payload)),
+							ns_per_message(construct<Message>(payload)),
+							ns_per_message(queue<HeapMessage>(payload)),
+							ns_per_message(queue<Message>(payload)));
+			}
+		}
+
+		const Registration registration("message", "Message construction and SpscQueue<Message> round trip, inline vs heap payload", run);
+	}
+}
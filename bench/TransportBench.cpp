@@ -0,0 +1,216 @@
+#include "Bench.hpp"
+
+#include "transport/Framer.hpp"
+#include "transport/IoUring.hpp"
+#include "transport/UringTransport.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <pty.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace wm::transport;
+using namespace wm::messages;
+
+namespace wm::bench
+{
+	namespace
+	{
+		constexpr size_t FRAME_COUNT = 20000;
+		constexpr size_t PAYLOAD_SIZE = 32;
+		constexpr auto RUN_TIMEOUT = std::chrono::seconds(20);
+
+		/**
+		 * @struct Pty
+		 * @brief A raw pseudo-terminal pair; the transport opens the slave by name.
+		 */
+		struct Pty
+		{
+			int master = -1;
+			int slave = -1;
+			std::string name;
+
+			Pty()
+			{
+				char path[64];
+				if (openpty(&master, &slave, path, nullptr, nullptr) != 0)
+				{
+					throw std::runtime_error("openpty failed");
+				}
+				name = path;
+
+				struct termios raw;
+				tcgetattr(master, &raw);
+				cfmakeraw(&raw);
+				tcsetattr(master, TCSANOW, &raw);
+			}
+
+			~Pty()
+			{
+				::close(master);
+				::close(slave);
+			}
+		};
+
+		struct Result
+		{
+			size_t frames = 0;
+			double seconds = 0;
+			SyscallCounters counters;
+		};
+
+		std::vector<char> message_bytes()
+		{
+			std::vector<char> payload(PAYLOAD_SIZE, 'x');
+			return Message(1, MessageType::Data, payload).serialize();
+		}
+
+		std::unique_ptr<UartTransport> open_transport(const Pty &pty, IoBackend backend)
+		{
+			SerialConfig config;
+			config.port = pty.name;
+			config.io_backend = backend;
+			config.rx_queue_depth = 4096;
+			config.tx_buffer_size = 16384;
+			config.rx_buffer_size = 16384;
+
+			auto transport = createSerialTransport(config);
+			if (transport->open() != ErrorCode::Success)
+			{
+				throw std::runtime_error("Failed to open " + pty.name);
+			}
+			return transport;
+		}
+
+		/// Peer writes FRAME_COUNT frames into the master side; the transport frames and dispatches them.
+		Result receive_frames(IoBackend backend)
+		{
+			Pty pty;
+			auto transport = open_transport(pty, backend);
+
+			std::atomic<size_t> received{0};
+			auto subscription = transport->subscribeReceive([&received](const MessageView &)
+															{ received.fetch_add(1, std::memory_order_relaxed); });
+
+			auto message = message_bytes();
+			std::vector<char> wire;
+			Framer framer;
+			for (size_t i = 0; i < FRAME_COUNT; ++i)
+			{
+				framer.writeFrame(message.data(), message.size(), [&wire](const char *bytes, size_t count)
+								  { wire.insert(wire.end(), bytes, bytes + count); });
+			}
+
+			SyscallCounters peer;
+			auto before = SyscallCounters::process();
+			auto start = Clock::now();
+
+			std::thread writer([&]
+							   {
+				auto peer_before = SyscallCounters::thread();
+				for (size_t offset = 0; offset < wire.size();)
+				{
+					ssize_t written = ::write(pty.master, wire.data() + offset, std::min<size_t>(4096, wire.size() - offset));
+					if (written <= 0)
+					{
+						break;
+					}
+					offset += static_cast<size_t>(written);
+				}
+				peer = SyscallCounters::thread() - peer_before; });
+
+			while (received.load(std::memory_order_relaxed) < FRAME_COUNT && Clock::now() - start < RUN_TIMEOUT)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(200));
+			}
+
+			Result result;
+			result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			result.frames = received.load();
+			writer.join();
+			result.counters = SyscallCounters::process() - before - peer;
+
+			transport->close();
+			return result;
+		}
+
+		/// The transport sends FRAME_COUNT frames; the peer drains the master side.
+		Result send_frames(IoBackend backend)
+		{
+			Pty pty;
+			auto transport = open_transport(pty, backend);
+
+			auto message = message_bytes();
+			size_t wire_size = Framer().maxWireSize(message.size());
+			size_t expected = wire_size * FRAME_COUNT;
+
+			SyscallCounters peer;
+			std::atomic<size_t> drained{0};
+			auto before = SyscallCounters::process();
+			auto start = Clock::now();
+
+			std::thread reader([&]
+							   {
+				auto peer_before = SyscallCounters::thread();
+				char buffer[4096];
+				while (drained.load(std::memory_order_relaxed) < expected && Clock::now() - start < RUN_TIMEOUT)
+				{
+					ssize_t count = ::read(pty.master, buffer, sizeof(buffer));
+					if (count <= 0)
+					{
+						break;
+					}
+					drained.fetch_add(static_cast<size_t>(count), std::memory_order_relaxed);
+				}
+				peer = SyscallCounters::thread() - peer_before; });
+
+			for (size_t i = 0; i < FRAME_COUNT; ++i)
+			{
+				transport->send(message.data(), message.size());
+			}
+			reader.join();
+
+			Result result;
+			result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			result.frames = drained.load() / wire_size;
+			result.counters = SyscallCounters::process() - before - peer;
+
+			transport->close();
+			return result;
+		}
+
+		void print_result(const char *backend, const char *direction, const Result &result)
+		{
+			double frames = static_cast<double>(std::max<size_t>(result.frames, 1));
+			std::printf("%-8s %-8s %8zu %12.0f %14.3f %16.3f\n", backend, direction, result.frames,
+						static_cast<double>(result.frames) / result.seconds,
+						static_cast<double>(result.counters.rw_calls) / frames,
+						static_cast<double>(result.counters.context_switches) / frames);
+		}
+
+		void run()
+		{
+			std::printf("%zu frames of %zu payload bytes each way over a pty pair\n", FRAME_COUNT, PAYLOAD_SIZE);
+			std::printf("Peer thread excluded from the counters. rw calls: read/write-family\n");
+			std::printf("syscalls; blocking waits (epoll_wait, io_uring_enter, futex) show up as switches.\n\n");
+			std::printf("%-8s %-8s %8s %12s %14s %16s\n", "backend", "dir", "frames", "frames/s", "rw calls/frm", "ctx switch/frm");
+
+			for (auto backend : {IoBackend::Epoll, IoBackend::IoUring})
+			{
+				const char *name = backend == IoBackend::Epoll ? "epoll" : "io_uring";
+				if (backend == IoBackend::IoUring && !IoUring::isSupported())
+				{
+					std::printf("%-8s not supported by this kernel\n", name);
+					continue;
+				}
+
+				print_result(name, "rx", receive_frames(backend));
+				print_result(name, "tx", send_frames(backend));
+			}
+		}
+
+		const Registration registration("transport", "epoll vs io_uring UART backend over a pty pair", run);
+	}
+}
@@ -0,0 +1,94 @@
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/resource.h>
+
+namespace wm::bench
+{
+	std::vector<Benchmark> &registry()
+	{
+		static std::vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	namespace
+	{
+		uint64_t read_io_calls(const char *path)
+		{
+			std::ifstream io(path);
+			std::string key;
+			uint64_t value = 0;
+			uint64_t calls = 0;
+			while (io >> key >> value)
+			{
+				if (key == "syscr:" || key == "syscw:")
+				{
+					calls += value;
+				}
+			}
+			return calls;
+		}
+
+		uint64_t read_context_switches(int who)
+		{
+			struct rusage usage{};
+			getrusage(who, &usage);
+			return static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+		}
+	}
+
+	SyscallCounters SyscallCounters::process()
+	{
+		return {read_io_calls("/proc/self/io"), read_context_switches(RUSAGE_SELF)};
+	}
+
+	SyscallCounters SyscallCounters::thread()
+	{
+		return {read_io_calls("/proc/thread-self/io"), read_context_switches(RUSAGE_THREAD)};
+	}
+
+	void print_heading(const std::string &title)
+	{
+		std::printf("\n== %s ==\n", title.c_str());
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	using namespace wm::bench;
+
+	if (argc > 1 && std::strcmp(argv[1], "--list") == 0)
+	{
+		for (const auto &benchmark : registry())
+		{
+			std::printf("%-12s %s\n", benchmark.name.c_str(), benchmark.description.c_str());
+		}
+		return 0;
+	}
+
+	int ran = 0;
+	for (const auto &benchmark : registry())
+	{
+		bool selected = argc == 1;
+		for (int i = 1; i < argc; ++i)
+		{
+			selected = selected || benchmark.name == argv[i];
+		}
+
+		if (selected)
+		{
+			print_heading(benchmark.name + ": " + benchmark.description);
+			benchmark.run();
+			++ran;
+		}
+	}
+
+	if (ran == 0)
+	{
+		std::fprintf(stderr, "No benchmark matches; use --list to see the names\n");
+		return 1;
+	}
+	return 0;
+}
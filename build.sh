@@ -26,4 +26,6 @@ echo   "./build/hardware_proto shift              # Runs TestDevice with shift p
 echo   "./build/hardware_proto shift led          # Runs LedController with shift protocol (default 0x69)"
 
 echo   "./build/hardware_proto shift 0x21         # Runs TestDevice with shift protocol (custom value)"
-echo   "./build/hardware_proto shift 0x31 led     # Runs LedController with shift protocol (custom value)"
\ No newline at end of file
+echo   "./build/hardware_proto shift 0x31 led     # Runs LedController with shift protocol (custom value)"
+
+echo   "./build/hardware_proto_bench [--list] [name...] # Runs the benchmarks"
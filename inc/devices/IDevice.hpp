@@ -98,14 +98,30 @@ namespace wm
 			 * that needs to be processed by the device. Derived classes can override
 			 * this to implement custom message handling.
 			 * 
-			 * @param data The received Message object.
+			 * @param data View of the received message, valid only during the call.
 			 */
-			virtual void onNotifyReceive(const Message &data) {};
+			virtual void onNotifyReceive(const MessageView &data) {};
 
 			/// @brief Logging tag for debug output.
 			static constexpr const char *TAG = "[IDevice] ";
 
 		protected:
+			/**
+			 * @brief Encodes a message with the protocol adapter and sends it.
+			 * 
+			 * The message is encoded straight into the transport's transmit buffer
+			 * through ITransport::sendInPlace(), without a temporary vector.
+			 * 
+			 * @param mes The Message to send.
+			 * 
+			 * @return Number of bytes sent, or negative value on error.
+			 */
+			int sendMessage(const Message &mes)
+			{
+				return m_transport->sendInPlace(m_protocol->encodedSize(mes), [this, &mes](std::span<char> out)
+												{ return m_protocol->encodeInto(mes, out); });
+			}
+
 			protoc::IProtocolAdapter *m_protocol = nullptr;
 			transport::ITransport *m_transport = nullptr;
 		};
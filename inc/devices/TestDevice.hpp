@@ -99,9 +99,9 @@ namespace wm::devices
          * Overrides IDevice::onNotifyReceive() to print received message details.
          * This is useful for debugging and testing.
          * 
-         * @param data The received Message object.
+         * @param data View of the received message.
          */
-        void onNotifyReceive(const Message &data) override
+        void onNotifyReceive(const MessageView &data) override
         {
             std::cout << TAG << "Received message notification:" << std::endl;
             data.print();
@@ -130,5 +130,8 @@ namespace wm::devices
          * @return true if the data was sent successfully, false otherwise.
          */
         bool sendRaw(const std::vector<char> &data);
+
+        /// @brief Receive subscription; released with the device so no callback outlives it.
+        transport::ReceiveSubscription m_subscription;
     };
 }
\ No newline at end of file
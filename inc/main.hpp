@@ -28,6 +28,7 @@ namespace wm
 #include "devices/LedControllerDevice.hpp"
 #include "protocols/PlainProtocol.hpp"
 #include "protocols/ShiftProtocol.hpp"
+#include "protocols/ChecksumProtocol.hpp"
 #include <format>
 #include <cstring>
 #include <thread>
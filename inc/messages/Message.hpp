@@ -3,9 +3,13 @@
 #include <cstdint>
 #include <cassert>
 #include <vector>
+#include <span>
+#include <cstring>
+#include <type_traits>
 #include <transport/TransportTypes.hpp>
 #include <stdexcept>
 #include "MessageTypes.hpp"
+#include "MessageView.hpp"
 
 namespace wm::messages
 {
@@ -34,8 +38,12 @@ namespace wm::messages
         uint32_t idx;
         /// @brief The type of message (Command, Response, Data, etc.).
         MessageType mesType;
-        /// @brief Message payload data.
-        VectorChar data;
+        /// @brief Message payload data, stored inline.
+        Payload data;
+        /// @brief When the first byte of the frame was read (monotonic), 0 if not received from a transport.
+        transport::Timestamp rx_timestamp{0};
+        /// @brief Kernel receive time in nanoseconds since the Unix epoch (SO_TIMESTAMPNS), 0 if the transport has none.
+        uint64_t kernel_rx_timestamp{0};
 
         /**
          * @brief Default constructor creating an empty message.
@@ -58,7 +66,7 @@ namespace wm::messages
         /**
          * @brief Constructs a message with index, type, and payload data.
          * 
-         * @tparam T The payload data type (must be compatible with VectorChar).
+         * @tparam T The payload data type (must be compatible with Payload).
          * @param index The message identifier.
          * @param type The MessageType for this message.
          * @param payload The message payload data.
@@ -66,7 +74,7 @@ namespace wm::messages
         template <typename T>
         Message(uint32_t index, MessageType type, const T &payload) : idx(index), mesType(type), data(payload)
         {
-            this->len = static_cast<uint8_t>(sizeof(idx) + sizeof(mesType) + data.get().size());
+            this->len = static_cast<uint8_t>(sizeof(idx) + sizeof(mesType) + data.size());
         }
 
         /**
@@ -82,17 +90,51 @@ namespace wm::messages
          */
         std::vector<char> serialize() const
         {
-            std::vector<char> buffer;
-            buffer.push_back(static_cast<char>(data.get().size()) + sizeof(idx) + sizeof(mesType));
-            buffer.push_back(static_cast<uint8_t>(mesType));
+            std::vector<char> buffer(serializedSize());
+            serializeInto(buffer);
+            return buffer;
+        }
 
-            buffer.push_back((idx >> 24) & 0xFF);
-            buffer.push_back((idx >> 16) & 0xFF);
-            buffer.push_back((idx >> 8) & 0xFF);
-            buffer.push_back((idx >> 0) & 0xFF);
+        /**
+         * @brief Gets the number of bytes serialize() produces for this message.
+         * 
+         * @return Serialized size including the length byte.
+         */
+        size_t serializedSize() const
+        {
+            return MessageView::PREAMBLE_SIZE + data.size();
+        }
 
-            buffer.insert(buffer.end(), data.get().begin(), data.get().end());
-            return buffer;
+        /**
+         * @brief Serializes the message into a caller-provided buffer.
+         * 
+         * Writes the same wire format as serialize() without allocating.
+         * 
+         * @param out Destination buffer, at least serializedSize() bytes long.
+         * 
+         * @return Number of bytes written.
+         * 
+         * @throws std::runtime_error If out is smaller than serializedSize().
+         * 
+         * @see serialize
+         */
+        size_t serializeInto(std::span<char> out) const
+        {
+            size_t size = serializedSize();
+            if (out.size() < size)
+                throw std::runtime_error("Output buffer too small for message");
+
+            out[0] = static_cast<char>(size - 1);
+            out[1] = static_cast<char>(mesType);
+
+            out[2] = static_cast<char>((idx >> 24) & 0xFF);
+            out[3] = static_cast<char>((idx >> 16) & 0xFF);
+            out[4] = static_cast<char>((idx >> 8) & 0xFF);
+            out[5] = static_cast<char>((idx >> 0) & 0xFF);
+
+            if (!data.empty())
+                std::memcpy(out.data() + MessageView::PREAMBLE_SIZE, data.data(), data.size());
+            return size;
         }
 
         /**
@@ -131,29 +173,25 @@ namespace wm::messages
          */
         static Message deserialize(const char *rxBuff, size_t buffLen)
         {
-            if (buffLen < m_preambleSize)
-                throw std::runtime_error("Buffer too small:  need at least 5 bytes");
-            if (buffLen > 255)
-                throw std::runtime_error("Buffer too large: maximum size is 255 bytes");
-
-            Message msg;
-
-            msg.len = rxBuff[0];
-
-            msg.mesType = intToMessageType(rxBuff[1]);
-
-            msg.idx = (static_cast<uint32_t>(rxBuff[2]) << 24) |
-                      (static_cast<uint32_t>(rxBuff[3]) << 16) |
-                      (static_cast<uint32_t>(rxBuff[4]) << 8) |
-                      (static_cast<uint32_t>(rxBuff[5]) << 0);
-
-            std::vector<char> vec;
-            vec.assign(rxBuff + m_preambleSize, rxBuff + msg.len + 1);
-            msg.data = VectorChar(vec);
-
-            return msg;
+            return MessageView::decode(rxBuff, buffLen).toOwned();
         };
 
+        /**
+         * @brief Gets a non-owning view of this message.
+         * 
+         * The view references this message's payload and is invalidated when
+         * the message is modified or destroyed.
+         * 
+         * @return A MessageView over this message.
+         */
+        MessageView view() const
+        {
+            MessageView view(len, idx, mesType, data.get());
+            view.rx_timestamp = rx_timestamp;
+            view.kernel_rx_timestamp = kernel_rx_timestamp;
+            return view;
+        }
+
         /**
          * @brief Prints the message contents to standard output.
          * 
@@ -162,28 +200,7 @@ namespace wm::messages
          */
         void print() const
         {
-            printf("Message:\n");
-            printf("  len: %u\n", len);
-            printf("  idx:  0x%08X (%u)\n", idx, idx);
-            printf("  message_type:  0x%08X (%u-%s)\n", static_cast<uint8_t>(mesType), static_cast<uint8_t>(mesType), messageTypeToString(mesType));
-            printf("  data (%zu bytes): ", data.get().size());
-            for (auto c : data.get())
-            {
-                printf("%02X ", static_cast<uint8_t>(c));
-            }
-            printf("\n  data (ASCII): ");
-            for (auto c : data.get())
-            {
-                if (c >= 32 && c <= 126)
-                {
-                    printf("%c", c);
-                }
-                else
-                {
-                    printf(".");
-                }
-            }
-            printf("\n");
+            view().print();
         }
 
         /**
@@ -199,9 +216,15 @@ namespace wm::messages
         {
             return this->idx == mes.idx && this->len == mes.len;
         }
-
-    private:
-        /// @brief Size of message preamble (length + type + index) in bytes.
-        static constexpr uint8_t m_preambleSize = sizeof(len) + sizeof(mesType) + sizeof(idx);
     };
+
+    inline Message MessageView::toOwned() const
+    {
+        Message owned(idx, mesType, Payload(data));
+        owned.rx_timestamp = rx_timestamp;
+        owned.kernel_rx_timestamp = kernel_rx_timestamp;
+        return owned;
+    }
+
+    static_assert(std::is_trivially_copyable_v<Message>, "Message must stay trivially copyable");
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <vector>
 #include <string>
 #include <cstring>
+#include <span>
+#include <stdexcept>
 
 namespace wm::messages
 {
@@ -79,28 +81,47 @@ namespace wm::messages
     }
 
     /**
-     * @class VectorChar
-     * @brief A wrapper class for std::vector<char> with multiple construction options.
+     * @class Payload
+     * @brief Fixed-capacity message payload stored inline.
      * 
-     * VectorChar provides a flexible container for character data with various constructors
-     * to accept different input types (C-strings, std::string, integers, vectors, etc.).
-     * It simplifies the creation of message payloads from diverse data types.
+     * A serialized message is at most 255 bytes, 6 of which are the length, type
+     * and index, so a payload never exceeds 249 bytes. Payload keeps those bytes
+     * in an inline array instead of on the heap, which makes Message trivially
+     * copyable and allocation-free. Constructors accept the same input types the
+     * former vector-based container did (C-strings, std::string, single bytes,
+     * vectors).
      */
-    class VectorChar
+    class Payload
     {
     public:
+        /// @brief Maximum number of payload bytes in one message.
+        static constexpr size_t CAPACITY = 249;
+
         /**
-         * @brief Default constructor creating an empty data container.
+         * @brief Default constructor creating an empty payload.
+         */
+        Payload() = default;
+
+        /**
+         * @brief Constructs from a raw byte range.
+         * 
+         * @param bytes Pointer to the bytes to copy.
+         * @param length Number of bytes to copy.
+         * 
+         * @throws std::runtime_error If length exceeds CAPACITY.
          */
-        VectorChar() = default;
+        Payload(const char *bytes, size_t length)
+        {
+            assign(bytes, length);
+        }
 
         /**
          * @brief Constructs from a C-string.
          * 
          * @param str Pointer to a null-terminated C-string.
          */
-        VectorChar(const char *str)
-            : m_data(str, str + std::strlen(str))
+        Payload(const char *str)
+            : Payload(str, std::strlen(str))
         {
         }
 
@@ -109,8 +130,8 @@ namespace wm::messages
          * 
          * @param str Reference to a std::string.
          */
-        VectorChar(const std::string &str)
-            : m_data(str.begin(), str.end())
+        Payload(const std::string &str)
+            : Payload(str.data(), str.size())
         {
         }
 
@@ -119,8 +140,8 @@ namespace wm::messages
          * 
          * @param value The byte value to store.
          */
-        VectorChar(uint8_t value)
-            : m_data{static_cast<char>(value)}
+        Payload(uint8_t value)
+            : Payload(static_cast<char>(value))
         {
         }
 
@@ -129,35 +150,40 @@ namespace wm::messages
          * 
          * @param value The character to store.
          */
-        VectorChar(char value)
-            : m_data{value}
+        Payload(char value)
+            : m_size(1)
         {
+            m_data[0] = value;
         }
 
         /**
-         * @brief Constructs from a vector of chars (move semantics).
+         * @brief Constructs from a span of chars.
          * 
-         * @param data The vector to move into this object.
+         * @param bytes The bytes to copy.
          */
-        VectorChar(const std::vector<char> &data)
-            : m_data(std::move(data))
+        Payload(std::span<const char> bytes)
+            : Payload(bytes.data(), bytes.size())
         {
         }
 
         /**
-         * @brief Constructs from a vector of uint8_t values.
+         * @brief Constructs from a vector of chars.
          * 
-         * Converts each uint8_t value to a char.
+         * @param data The vector to copy.
+         */
+        Payload(const std::vector<char> &data)
+            : Payload(data.data(), data.size())
+        {
+        }
+
+        /**
+         * @brief Constructs from a vector of uint8_t values.
          * 
-         * @param data The vector of bytes to convert and store.
+         * @param data The vector of bytes to copy.
          */
-        VectorChar(const std::vector<uint8_t> &data)
+        Payload(const std::vector<uint8_t> &data)
+            : Payload(reinterpret_cast<const char *>(data.data()), data.size())
         {
-            m_data.reserve(data.size());
-            for (uint8_t byte : data)
-            {
-                m_data.push_back(static_cast<char>(byte));
-            }
         }
 
         /**
@@ -166,31 +192,81 @@ namespace wm::messages
          * Prevents implicit construction from unsupported types.
          */
         template <typename T>
-        VectorChar(const T &) = delete;
+        Payload(const T &) = delete;
 
         /**
-         * @brief Moves the internal data vector.
+         * @brief Replaces the contents with a copy of the given bytes.
          * 
-         * @return rvalue reference to the internal vector.
+         * @param bytes Pointer to the bytes to copy.
+         * @param length Number of bytes to copy.
+         * 
+         * @throws std::runtime_error If length exceeds CAPACITY.
          */
-        std::vector<char> &&move() { return std::move(m_data); }
-        
+        void assign(const char *bytes, size_t length)
+        {
+            if (length > CAPACITY)
+                throw std::runtime_error("Payload too large: maximum size is 249 bytes");
+
+            if (length > 0)
+                std::memcpy(m_data, bytes, length);
+            m_size = static_cast<uint8_t>(length);
+        }
+
         /**
-         * @brief Gets a reference to the internal data vector.
+         * @brief Gets the number of stored bytes.
          * 
-         * @return Mutable reference to the underlying vector.
+         * @return Payload size in bytes.
          */
-        std::vector<char> &get() { return m_data; }
-        
+        size_t size() const { return m_size; }
+
+        /**
+         * @brief Checks whether the payload is empty.
+         * 
+         * @return true if no bytes are stored.
+         */
+        bool empty() const { return m_size == 0; }
+
         /**
-         * @brief Gets a const reference to the internal data vector.
+         * @brief Gets a pointer to the stored bytes.
          * 
-         * @return Const reference to the underlying vector.
+         * @return Pointer to the first payload byte.
          */
-        const std::vector<char> &get() const { return m_data; }
+        char *data() { return m_data; }
+
+        /**
+         * @brief Gets a const pointer to the stored bytes.
+         * 
+         * @return Pointer to the first payload byte.
+         */
+        const char *data() const { return m_data; }
+
+        /**
+         * @brief Gets a mutable view of the stored bytes.
+         * 
+         * @return Span over the payload.
+         */
+        std::span<char> get() { return {m_data, m_size}; }
+
+        /**
+         * @brief Gets a const view of the stored bytes.
+         * 
+         * @return Span over the payload.
+         */
+        std::span<const char> get() const { return {m_data, m_size}; }
+
+        char *begin() { return m_data; }
+        char *end() { return m_data + m_size; }
+        const char *begin() const { return m_data; }
+        const char *end() const { return m_data + m_size; }
 
     protected:
-        std::vector<char> m_data;
+        /// @brief Inline payload storage; only the first m_size bytes are meaningful.
+        char m_data[CAPACITY];
+        /// @brief Number of stored bytes.
+        uint8_t m_size{0};
     };
 
+    /// @brief Former name of Payload, kept for source compatibility.
+    using VectorChar = Payload;
+
 }
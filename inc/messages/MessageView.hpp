@@ -0,0 +1,133 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <stdexcept>
+#include <transport/TransportTypes.hpp>
+#include "MessageTypes.hpp"
+
+namespace wm::messages
+{
+    class Message;
+
+    /**
+     * @class MessageView
+     * @brief Non-owning view of a serialized message.
+     *
+     * MessageView decodes the header fields of a frame and references its payload
+     * in place, without allocating or copying. It is what transports deliver to
+     * receive subscribers: the referenced bytes are only valid for the duration of
+     * the callback, so subscribers that need to keep the message must call toOwned().
+     *
+     * The wire format is the same as Message (length, type, 32-bit index, payload).
+     */
+    class MessageView
+    {
+    public:
+        /// @brief Size of message preamble (length + type + index) in bytes.
+        static constexpr size_t PREAMBLE_SIZE = sizeof(uint8_t) + sizeof(MessageType) + sizeof(uint32_t);
+        /// @brief Maximum size of a serialized message in bytes.
+        static constexpr size_t MAX_SIZE = 255;
+
+        /// @brief Message length (payload size + type + index).
+        uint8_t len{0};
+        /// @brief Message identifier for tracking and correlation.
+        uint32_t idx{0};
+        /// @brief The type of message (Command, Response, Data, etc.).
+        MessageType mesType{MessageType::Undefined};
+        /// @brief Payload bytes, referencing the buffer the view was decoded from.
+        std::span<const char> data;
+        /// @brief When the first byte of the frame was read (monotonic), 0 if not received from a transport.
+        transport::Timestamp rx_timestamp{0};
+        /// @brief Kernel receive time in nanoseconds since the Unix epoch (SO_TIMESTAMPNS), 0 if the transport has none.
+        uint64_t kernel_rx_timestamp{0};
+
+        /**
+         * @brief Default constructor creating an empty, undefined view.
+         */
+        MessageView() = default;
+
+        /**
+         * @brief Constructs a view from already decoded fields.
+         *
+         * @param length The message length field.
+         * @param index The message identifier.
+         * @param type The MessageType of the message.
+         * @param payload The payload bytes to reference.
+         */
+        MessageView(uint8_t length, uint32_t index, MessageType type, std::span<const char> payload)
+            : len(length), idx(index), mesType(type), data(payload)
+        {
+        }
+
+        /**
+         * @brief Decodes a view from a serialized frame without copying the payload.
+         *
+         * @param frame Pointer to the serialized bytes, starting with the length byte.
+         * @param size Number of bytes available at frame.
+         *
+         * @return A view whose payload points into frame.
+         *
+         * @throws std::runtime_error If the buffer is too small, too large, or shorter than the length byte claims.
+         */
+        static MessageView decode(const char *frame, size_t size)
+        {
+            if (size < PREAMBLE_SIZE)
+                throw std::runtime_error("Buffer too small: need at least 6 bytes");
+            if (size > MAX_SIZE)
+                throw std::runtime_error("Buffer too large: maximum size is 255 bytes");
+
+            uint8_t length = static_cast<uint8_t>(frame[0]);
+            if (length < PREAMBLE_SIZE - 1 || static_cast<size_t>(length) + 1 > size)
+                throw std::runtime_error("Length byte does not match buffer size");
+
+            const auto *bytes = reinterpret_cast<const uint8_t *>(frame);
+            uint32_t index = (static_cast<uint32_t>(bytes[2]) << 24) |
+                             (static_cast<uint32_t>(bytes[3]) << 16) |
+                             (static_cast<uint32_t>(bytes[4]) << 8) |
+                             (static_cast<uint32_t>(bytes[5]) << 0);
+
+            return MessageView(length, index, intToMessageType(bytes[1]),
+                               std::span<const char>(frame + PREAMBLE_SIZE, length + 1 - PREAMBLE_SIZE));
+        }
+
+        /**
+         * @brief Copies the viewed message into an owning Message.
+         *
+         * @return A Message holding a copy of the header fields and payload.
+         */
+        Message toOwned() const;
+
+        /**
+         * @brief Prints the message contents to standard output.
+         *
+         * Displays the message structure including length, index, type, and payload data
+         * in both hexadecimal and ASCII formats for debugging purposes.
+         */
+        void print() const
+        {
+            printf("Message:\n");
+            printf("  len: %u\n", len);
+            printf("  idx:  0x%08X (%u)\n", idx, idx);
+            printf("  message_type:  0x%08X (%u-%s)\n", static_cast<uint8_t>(mesType), static_cast<uint8_t>(mesType), messageTypeToString(mesType));
+            printf("  data (%zu bytes): ", data.size());
+            for (auto c : data)
+            {
+                printf("%02X ", static_cast<uint8_t>(c));
+            }
+            printf("\n  data (ASCII): ");
+            for (auto c : data)
+            {
+                if (c >= 32 && c <= 126)
+                {
+                    printf("%c", c);
+                }
+                else
+                {
+                    printf(".");
+                }
+            }
+            printf("\n");
+        }
+    };
+}
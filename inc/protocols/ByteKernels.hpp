@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace wm::protoc
+{
+	/// @brief 256-entry byte substitution table: output byte = table[input byte].
+	using ByteTable = std::array<uint8_t, 256>;
+
+	/**
+	 * @struct SubstitutionTable
+	 * @brief A ByteTable together with the layout the vector lookups need.
+	 *
+	 * Built once per table so that substitute_bytes() does no setup per call.
+	 */
+	struct SubstitutionTable
+	{
+		/**
+		 * @brief Prepares table for substitute_bytes().
+		 *
+		 * @param table Output byte for every input byte.
+		 */
+		explicit SubstitutionTable(const ByteTable &table);
+
+		/// @brief Output byte for every input byte.
+		ByteTable bytes;
+		/// @brief Each half of bytes as XOR differences between consecutive 16-byte rows.
+		ByteTable row_diffs;
+	};
+
+	/**
+	 * @brief Computes the table that undoes a substitution.
+	 *
+	 * @param table Substitution table; every byte value must appear exactly once.
+	 *
+	 * @return inverse with inverse[table[b]] == b for every byte b.
+	 *
+	 * @throws std::invalid_argument If table is not a permutation.
+	 */
+	ByteTable invert_byte_table(const ByteTable &table);
+
+	/**
+	 * @brief Adds delta to every byte, modulo 256.
+	 *
+	 * A plain loop the compiler vectorizes; the same code runs whatever
+	 * byte_kernels_isa() reports. src and dst may be the same buffer.
+	 *
+	 * @param src Input bytes.
+	 * @param dst Output buffer, at least size bytes.
+	 * @param size Number of bytes.
+	 * @param delta Value added to each byte.
+	 */
+	void add_bytes(const char *src, char *dst, size_t size, uint8_t delta);
+
+	/**
+	 * @brief Maps every byte through a substitution table.
+	 *
+	 * Uses vpermi2b (AVX-512 VBMI) or pshufb (AVX2) lookups when the CPU
+	 * has them and a scalar loop otherwise. src and dst may be the same buffer.
+	 *
+	 * @param src Input bytes.
+	 * @param dst Output buffer, at least size bytes.
+	 * @param size Number of bytes.
+	 * @param table Substitution table.
+	 */
+	void substitute_bytes(const char *src, char *dst, size_t size, const SubstitutionTable &table);
+
+	/**
+	 * @brief Gets the instruction set the kernels picked on this CPU.
+	 *
+	 * @return "avx512vbmi", "avx2" or "scalar".
+	 */
+	const char *byte_kernels_isa();
+
+	/**
+	 * @brief Makes the kernels use a narrower instruction set than the CPU has.
+	 *
+	 * Meant for benchmarks and for checking the fallbacks. Restore the default
+	 * by passing the name byte_kernels_isa() returned before the first call.
+	 *
+	 * @param isa "avx512vbmi", "avx2" or "scalar".
+	 *
+	 * @return false, leaving the selection unchanged, if isa is unknown or this CPU lacks it.
+	 */
+	bool set_byte_kernels_isa(const char *isa);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "IProtocolAdapter.hpp"
+#include <cstdint>
+
+namespace wm::protoc
+{
+	/// @brief Checksum appended by ChecksumProtocol.
+	enum class ChecksumType : uint8_t
+	{
+		Crc16Ccitt, ///< CRC-16/CCITT-FALSE, 2 bytes.
+		Crc32C,     ///< CRC-32C (Castagnoli), 4 bytes.
+	};
+
+	/**
+	 * @class ChecksumProtocol
+	 * @brief Protocol implementation that appends a CRC to every message.
+	 * 
+	 * The message is serialized as usual with the checksum appended big-endian
+	 * after the payload. The length byte counts the checksum, so the framers
+	 * deliver it with the frame, and the checksum covers every byte before it,
+	 * including the length byte.
+	 * 
+	 * feed() verifies the checksum and yields a view into the received frame
+	 * without copying. A mismatch throws transport::ChecksumException, which
+	 * the transports count in ITransport::checksumErrors() and drop the frame.
+	 * 
+	 * @note The checksum takes room from the payload: at most
+	 * Payload::CAPACITY - checksumSize() bytes fit in one message.
+	 */
+	class ChecksumProtocol : public IProtocolAdapter
+	{
+	public:
+		/**
+		 * @brief Constructs a ChecksumProtocol.
+		 * 
+		 * @param type The checksum to append and verify.
+		 */
+		explicit ChecksumProtocol(ChecksumType type = ChecksumType::Crc32C) : m_type(type) {}
+
+		/**
+		 * @brief Destructor.
+		 */
+		~ChecksumProtocol() override = default;
+
+		/**
+		 * @brief Serializes the message and appends its checksum.
+		 * 
+		 * @param mes The Message to encode.
+		 * @param out Destination buffer, at least encodedSize(mes) bytes long.
+		 * 
+		 * @return Number of bytes written.
+		 * 
+		 * @throws std::runtime_error If the message and checksum exceed MessageView::MAX_SIZE,
+		 * or out is smaller than encodedSize(mes).
+		 */
+		size_t encodeInto(const Message &mes, std::span<char> out) override;
+
+		/**
+		 * @brief Gets the serialized size plus the checksum.
+		 * 
+		 * @param mes The Message object to be encoded.
+		 * 
+		 * @return Number of bytes encodeInto() writes.
+		 */
+		size_t encodedSize(const Message &mes) const override
+		{
+			return mes.serializedSize() + checksumSize();
+		}
+
+		/**
+		 * @brief Verifies the checksum and decodes the message.
+		 * 
+		 * @param data Pointer to the encoded message buffer.
+		 * @param size The length of the buffer in bytes.
+		 * 
+		 * @return The decoded Message object.
+		 * 
+		 * @throws transport::ChecksumException If the checksum does not match.
+		 * @throws std::runtime_error If the buffer is not a valid frame.
+		 */
+		Message decode(const char *data, size_t size) override;
+
+		/**
+		 * @brief Verifies the checksum and yields a view into data.
+		 * 
+		 * @param data One encoded message.
+		 * @param on_message Called with the decoded message.
+		 * 
+		 * @return Always 1.
+		 * 
+		 * @throws transport::ChecksumException If the checksum does not match.
+		 * @throws std::runtime_error If data is not a valid frame.
+		 */
+		size_t feed(std::span<const char> data, const MessageSink &on_message) override;
+
+		/**
+		 * @brief Gets the number of checksum bytes appended to each message.
+		 * 
+		 * @return 2 for CRC-16, 4 for CRC-32C.
+		 */
+		size_t checksumSize() const { return m_type == ChecksumType::Crc16Ccitt ? 2 : 4; }
+
+		ChecksumType type() const { return m_type; }
+
+	private:
+		/**
+		 * @brief Computes the configured checksum.
+		 */
+		uint32_t compute(const char *data, size_t size) const;
+
+		/**
+		 * @brief Checks a frame's checksum and decodes it without the checksum bytes.
+		 * 
+		 * @return A view whose payload points into data.
+		 */
+		MessageView verify(const char *data, size_t size) const;
+
+		/// @brief The checksum appended and verified.
+		ChecksumType m_type;
+	};
+}
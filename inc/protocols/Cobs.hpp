@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace wm::protoc
+{
+	/// @brief Byte stuffing flavour used by the COBS codec.
+	enum class CobsVariant : uint8_t
+	{
+		Cobs,  ///< Consistent Overhead Byte Stuffing.
+		CobsR, ///< COBS/R: the last data byte may replace the final code byte, saving one byte on most frames.
+	};
+
+	/**
+	 * @brief Gets the largest number of bytes COBS adds to a frame.
+	 *
+	 * @param length Unencoded frame length.
+	 *
+	 * @return One code byte per started block of 254 bytes, not counting the delimiter.
+	 */
+	constexpr size_t cobs_max_overhead(size_t length)
+	{
+		return length / 254 + 1;
+	}
+
+	/**
+	 * @brief COBS-encodes a frame in a single pass.
+	 *
+	 * The output contains no 0x00 byte; the caller appends the delimiter. dst may
+	 * overlap src as long as it starts at least cobs_max_overhead(length) bytes
+	 * before it, which lets a frame be encoded in place behind reserved room.
+	 *
+	 * @param src Frame bytes.
+	 * @param length Number of frame bytes.
+	 * @param dst Output, at least length + cobs_max_overhead(length) bytes.
+	 * @param variant COBS or COBS/R.
+	 *
+	 * @return Number of bytes written to dst.
+	 */
+	size_t cobs_encode(const char *src, size_t length, char *dst, CobsVariant variant);
+
+	/**
+	 * @brief Decodes a COBS-encoded frame in place in a single pass.
+	 *
+	 * @param buffer Encoded bytes without the delimiter; replaced by the decoded frame.
+	 * @param size Number of encoded bytes.
+	 * @param variant COBS or COBS/R, as used by the encoder.
+	 *
+	 * @return Decoded length, or empty if buffer is not valid for variant.
+	 */
+	std::optional<size_t> cobs_decode(char *buffer, size_t size, CobsVariant variant);
+}
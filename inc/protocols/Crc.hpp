@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wm::protoc
+{
+	/**
+	 * @brief Computes CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection).
+	 *
+	 * Slice-by-8 table lookup; there is no CPU instruction for this polynomial.
+	 * Pass the previous result as crc to continue over several buffers.
+	 *
+	 * @param data Input bytes.
+	 * @param size Number of bytes.
+	 * @param crc Running value, 0xFFFF to start.
+	 *
+	 * @return The CRC of the bytes so far.
+	 */
+	uint16_t crc16_ccitt(const char *data, size_t size, uint16_t crc = 0xFFFF);
+
+	/**
+	 * @brief Computes CRC-32C (Castagnoli, reflected, init and final XOR 0xFFFFFFFF).
+	 *
+	 * Uses the SSE4.2 crc32 instruction when the CPU has it (checked once at
+	 * first use) and slice-by-8 tables otherwise. Pass the previous result as
+	 * crc to continue over several buffers.
+	 *
+	 * @param data Input bytes.
+	 * @param size Number of bytes.
+	 * @param crc Previous result, 0 to start.
+	 *
+	 * @return The CRC of the bytes so far.
+	 */
+	uint32_t crc32c(const char *data, size_t size, uint32_t crc = 0);
+
+	/**
+	 * @brief Gets the CRC-32C implementation picked on this CPU.
+	 *
+	 * @return "sse4.2" or "slice-by-8".
+	 */
+	const char *crc32c_isa();
+
+	/**
+	 * @brief Makes crc32c() use the slice-by-8 tables even if the CPU has SSE4.2.
+	 *
+	 * Meant for benchmarks and for checking the fallback.
+	 *
+	 * @param isa "sse4.2" or "slice-by-8".
+	 *
+	 * @return false, leaving the selection unchanged, if isa is unknown or this CPU lacks it.
+	 */
+	bool set_crc32c_isa(const char *isa);
+}
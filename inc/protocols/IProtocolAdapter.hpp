@@ -6,6 +6,8 @@
 #include "messages/MessageTypes.hpp"
 #include <cstring>
 #include <concepts>
+#include <functional>
+#include <span>
 
 using namespace wm::messages;
 
@@ -28,6 +30,9 @@ namespace wm::protoc
 	class IProtocolAdapter
 	{
 	public:
+		/// @brief Receives each message produced by feed(); the view is only valid during the call.
+		using MessageSink = std::function<void(const MessageView &)>;
+
 		/**
 		 * @brief Default constructor.
 		 */
@@ -41,15 +46,46 @@ namespace wm::protoc
 		/**
 		 * @brief Encodes a Message into a byte buffer for transmission.
 		 * 
-		 * Pure virtual method that must be implemented by derived classes to convert
-		 * a Message object into the protocol-specific binary format.
+		 * Thin wrapper around encodeInto() that allocates a buffer of
+		 * encodedSize() bytes.
 		 * 
 		 * @param mes The Message object to encode.
 		 * 
 		 * @return Vector of chars containing the encoded message bytes.
 		 */
-		virtual std::vector<char> encode(const Message &mes) = 0;
-		
+		virtual std::vector<char> encode(const Message &mes)
+		{
+			std::vector<char> encoded(encodedSize(mes));
+			encoded.resize(encodeInto(mes, encoded));
+			return encoded;
+		}
+
+		/**
+		 * @brief Encodes a Message directly into a caller-provided buffer.
+		 * 
+		 * Pure virtual method that must be implemented by derived classes to write
+		 * the protocol-specific binary format without allocating, for example
+		 * straight into a transport's transmit buffer.
+		 * 
+		 * @param mes The Message object to encode.
+		 * @param out Destination buffer, at least encodedSize(mes) bytes long.
+		 * 
+		 * @return Number of bytes written to out.
+		 */
+		virtual size_t encodeInto(const Message &mes, std::span<char> out) = 0;
+
+		/**
+		 * @brief Gets an upper bound on the encoded size of a Message.
+		 * 
+		 * @param mes The Message object to be encoded.
+		 * 
+		 * @return Maximum number of bytes encodeInto() writes for this message.
+		 */
+		virtual size_t encodedSize(const Message &mes) const
+		{
+			return mes.serializedSize();
+		}
+
 		/**
 		 * @brief Decodes a byte buffer into a Message object.
 		 * 
@@ -64,19 +100,44 @@ namespace wm::protoc
 		virtual Message decode(const char *data, size_t size) = 0;
 
 		/**
-		 * @brief Decodes a VectorChar buffer into a Message object.
+		 * @brief Decodes a Payload buffer into a Message object.
 		 * 
-		 * Convenience overload that decodes from a VectorChar object.
+		 * Convenience overload that decodes from a Payload object.
 		 * 
-		 * @param data Reference to a VectorChar containing the data to decode.
+		 * @param data Reference to a Payload containing the data to decode.
 		 * 
 		 * @return Reconstructed Message object.
 		 */
-		virtual Message decode(const VectorChar &data)
+		virtual Message decode(const Payload &data)
 		{
-			return this->decode(reinterpret_cast<const char *>(data.get().data()), data.get().size());
+			return this->decode(data.data(), data.size());
 		};
 
+		/**
+		 * @brief Decodes received bytes incrementally.
+		 * 
+		 * Transports bound to the adapter (ITransport::bindProtocol()) call this
+		 * from their receive path with every frame they extract, so decoding
+		 * happens once, before subscribers see the message. An adapter may yield
+		 * zero messages (and keep state for the next call) or several.
+		 * 
+		 * The default implementation decodes data as one frame through decode().
+		 * Overrides should avoid that copy where the wire format allows it.
+		 * 
+		 * @param data Received bytes; only valid during the call.
+		 * @param on_message Called with each decoded message.
+		 * 
+		 * @return Number of messages yielded.
+		 * 
+		 * @throws std::runtime_error If data cannot be decoded.
+		 */
+		virtual size_t feed(std::span<const char> data, const MessageSink &on_message)
+		{
+			Message mes = decode(data.data(), data.size());
+			on_message(mes.view());
+			return 1;
+		}
+
 		/**
 		 * @brief Creates a command message.
 		 * 
@@ -142,7 +203,7 @@ namespace wm::protoc
 		 */
 		Message createHeartbeat()
 		{
-			return createMessage(MessageType::HeartBeat, VectorChar{});
+			return createMessage(MessageType::HeartBeat, Payload{});
 		}
 
 		/**
@@ -178,7 +239,7 @@ namespace wm::protoc
 		template <typename T>
 		Message createMessage(MessageType type, const T &data)
 		{
-			return Message(m_mesCounter++, type, VectorChar(data));
+			return Message(m_mesCounter++, type, Payload(data));
 		}
 
 		/// @brief Internal counter for tracking message sequences.
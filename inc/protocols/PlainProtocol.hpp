@@ -36,10 +36,11 @@ namespace wm::protoc
 		 * without any additional encoding.
 		 * 
 		 * @param mes The Message to encode.
+		 * @param out Destination buffer.
 		 * 
-		 * @return The serialized message bytes.
+		 * @return Number of bytes written.
 		 */
-		std::vector<char> encode(const Message &mes) override;
+		size_t encodeInto(const Message &mes, std::span<char> out) override;
 
 		/**
 		 * @brief Decodes a plain binary message buffer.
@@ -52,5 +53,15 @@ namespace wm::protoc
 		 * @return The decoded Message object.
 		 */
 		Message decode(const char *data, size_t size) override;
+
+		/**
+		 * @brief Yields a view of the frame without copying it.
+		 * 
+		 * @param data One serialized message.
+		 * @param on_message Called with a view into data.
+		 * 
+		 * @return Always 1.
+		 */
+		size_t feed(std::span<const char> data, const MessageSink &on_message) override;
 	};
 }
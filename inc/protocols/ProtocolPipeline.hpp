@@ -0,0 +1,204 @@
+#pragma once
+
+#include "IProtocolAdapter.hpp"
+#include "ProtocolStage.hpp"
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace wm::protoc
+{
+	/**
+	 * @brief Copies a received frame into a buffer for the stages to decode in place.
+	 * 
+	 * @param data Received frame.
+	 * @param size Frame length.
+	 * @param buffer Destination of MessageView::MAX_SIZE bytes.
+	 * 
+	 * @return The copy, with capacity MessageView::MAX_SIZE.
+	 * 
+	 * @throws std::runtime_error If size is not a valid frame length.
+	 */
+	inline FrameBuffer copy_frame(const char *data, size_t size, char (&buffer)[MessageView::MAX_SIZE])
+	{
+		if (size < MessageView::PREAMBLE_SIZE || size > MessageView::MAX_SIZE)
+			throw std::runtime_error("Frame size out of range for protocol stages");
+
+		std::memcpy(buffer, data, size);
+		return FrameBuffer{buffer, size, MessageView::MAX_SIZE};
+	}
+
+	/**
+	 * @class ProtocolPipeline
+	 * @brief Protocol adapter built from a chain of stages chosen at runtime.
+	 * 
+	 * encodeInto() serializes the message once into the caller's buffer and
+	 * runs every stage's encode() over it in chain order; encodedSize()
+	 * reserves the stages' combined overhead as tailroom. On receive the frame
+	 * is copied once to a stack buffer and the stages' decode() run over it
+	 * in reverse order. No layer allocates.
+	 * 
+	 * Framing (length prefix, sync marker, COBS) stays with the transport's
+	 * SerialConfig::framing, which already reserves headroom for it.
+	 * 
+	 * @code
+	 * ProtocolPipeline protocol;
+	 * protocol.emplace<ShiftStage>(0x42).emplace<ChecksumStage>(ChecksumType::Crc16Ccitt);
+	 * @endcode
+	 */
+	class ProtocolPipeline : public IProtocolAdapter
+	{
+	public:
+		ProtocolPipeline() = default;
+		~ProtocolPipeline() override = default;
+
+		/**
+		 * @brief Appends a stage to the chain; the last stage added runs last when encoding.
+		 * 
+		 * Must not be called while the pipeline is bound to an open transport.
+		 * 
+		 * @param stage The stage to append.
+		 * 
+		 * @return *this, for chaining.
+		 */
+		ProtocolPipeline &add(std::unique_ptr<IProtocolStage> stage);
+
+		/**
+		 * @brief Constructs a stage in place and appends it.
+		 * 
+		 * @tparam S Stage type.
+		 * @param args Arguments forwarded to the stage's constructor.
+		 * 
+		 * @return *this, for chaining.
+		 */
+		template <typename S, typename... Args>
+		ProtocolPipeline &emplace(Args &&...args)
+		{
+			return add(std::make_unique<S>(std::forward<Args>(args)...));
+		}
+
+		/**
+		 * @brief Serializes the message and runs every stage's encode() over it.
+		 * 
+		 * @param mes The Message to encode.
+		 * @param out Destination buffer, at least encodedSize(mes) bytes long.
+		 * 
+		 * @return Number of bytes written.
+		 * 
+		 * @throws std::runtime_error If the encoded message exceeds MessageView::MAX_SIZE.
+		 */
+		size_t encodeInto(const Message &mes, std::span<char> out) override;
+
+		/**
+		 * @brief Gets the serialized size plus the overhead of every stage.
+		 */
+		size_t encodedSize(const Message &mes) const override
+		{
+			return mes.serializedSize() + m_overhead;
+		}
+
+		/**
+		 * @brief Runs the stages' decode() in reverse order and deserializes the result.
+		 * 
+		 * @param data Pointer to the encoded message buffer.
+		 * @param size The length of the buffer in bytes.
+		 * 
+		 * @return The decoded Message object.
+		 */
+		Message decode(const char *data, size_t size) override;
+
+		/**
+		 * @brief Decodes one frame in a stack buffer and yields a view into it.
+		 * 
+		 * Without stages the view points into data, as with PlainProtocol.
+		 * 
+		 * @param data One encoded message.
+		 * @param on_message Called with the decoded message.
+		 * 
+		 * @return Always 1.
+		 */
+		size_t feed(std::span<const char> data, const MessageSink &on_message) override;
+
+		/**
+		 * @brief Gets the number of stages in the chain.
+		 */
+		size_t stageCount() const { return m_stages.size(); }
+
+	private:
+		/**
+		 * @brief Runs every stage's decode(), last stage first.
+		 */
+		void decodeStages(FrameBuffer &frame) const;
+
+		/// @brief Stages in encoding order.
+		std::vector<std::unique_ptr<IProtocolStage>> m_stages;
+		/// @brief Sum of the stages' overhead().
+		size_t m_overhead{0};
+	};
+
+	/**
+	 * @class StaticProtocolPipeline
+	 * @brief Protocol adapter built from a chain of stages fixed at compile time.
+	 * 
+	 * Same wire format and buffer handling as ProtocolPipeline with the same
+	 * stages, but the stages are stored by value and called through their
+	 * concrete (final) types, so the compiler can inline the whole chain.
+	 * 
+	 * @code
+	 * StaticProtocolPipeline protocol(ShiftStage(0x42), ChecksumStage(ChecksumType::Crc32C));
+	 * @endcode
+	 * 
+	 * @tparam Stages Stage types, in encoding order.
+	 */
+	template <typename... Stages>
+	class StaticProtocolPipeline final : public IProtocolAdapter
+	{
+	public:
+		explicit StaticProtocolPipeline(Stages... stages) : m_stages(std::move(stages)...) {}
+
+		size_t encodeInto(const Message &mes, std::span<char> out) override
+		{
+			if (encodedSize(mes) > MessageView::MAX_SIZE)
+				throw std::runtime_error("Message too large for the protocol stages");
+
+			FrameBuffer frame{out.data(), mes.serializeInto(out), out.size()};
+			std::apply([&frame](const auto &...stage)
+					   { (stage.encode(frame), ...); }, m_stages);
+			return frame.size;
+		}
+
+		size_t encodedSize(const Message &mes) const override
+		{
+			return mes.serializedSize() + std::apply([](const auto &...stage)
+													 { return (stage.overhead() + ... + size_t{0}); }, m_stages);
+		}
+
+		Message decode(const char *data, size_t size) override
+		{
+			char buffer[MessageView::MAX_SIZE];
+			FrameBuffer frame = copy_frame(data, size, buffer);
+			decodeStages(frame, std::index_sequence_for<Stages...>{});
+			return Message::deserialize(frame.data, frame.size);
+		}
+
+		size_t feed(std::span<const char> data, const MessageSink &on_message) override
+		{
+			char buffer[MessageView::MAX_SIZE];
+			FrameBuffer frame = copy_frame(data.data(), data.size(), buffer);
+			decodeStages(frame, std::index_sequence_for<Stages...>{});
+			on_message(MessageView::decode(frame.data, frame.size));
+			return 1;
+		}
+
+	private:
+		template <size_t... I>
+		void decodeStages(FrameBuffer &frame, std::index_sequence<I...>) const
+		{
+			(std::get<sizeof...(Stages) - 1 - I>(m_stages).decode(frame), ...);
+		}
+
+		/// @brief Stages in encoding order.
+		std::tuple<Stages...> m_stages;
+	};
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "ByteKernels.hpp"
+#include "ChecksumProtocol.hpp"
+#include "Crc.hpp"
+#include "messages/MessageView.hpp"
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+
+namespace wm::protoc
+{
+	/**
+	 * @struct FrameBuffer
+	 * @brief A serialized message being transformed in place by protocol stages.
+	 *
+	 * data[0] is the length byte and always equals size - 1, so the frame stays
+	 * valid for the length-prefixed framers between stages.
+	 */
+	struct FrameBuffer
+	{
+		/// @brief Start of the frame (the length byte).
+		char *data;
+		/// @brief Current frame length.
+		size_t size;
+		/// @brief Bytes available at data; size may grow up to this.
+		size_t capacity;
+
+		/**
+		 * @brief Gets the bytes after the length, type and index.
+		 */
+		std::span<char> payload() const
+		{
+			return std::span<char>(data + MessageView::PREAMBLE_SIZE, size - MessageView::PREAMBLE_SIZE);
+		}
+
+		/**
+		 * @brief Changes the frame length and updates the length byte.
+		 *
+		 * @throws std::runtime_error If the new length is shorter than the preamble or exceeds capacity or MessageView::MAX_SIZE.
+		 */
+		void resize(size_t new_size)
+		{
+			if (new_size < MessageView::PREAMBLE_SIZE || new_size > capacity || new_size > MessageView::MAX_SIZE)
+				throw std::runtime_error("Frame size out of range for protocol stage");
+
+			size = new_size;
+			data[0] = static_cast<char>(new_size - 1);
+		}
+	};
+
+	/**
+	 * @class IProtocolStage
+	 * @brief One in-place transformation of a serialized message.
+	 *
+	 * Stages are chained by ProtocolPipeline (at runtime) or
+	 * StaticProtocolPipeline (at compile time). encode() runs in chain order on
+	 * the sender and decode() in reverse order on the receiver; both work on
+	 * the same buffer, so no stage allocates.
+	 *
+	 * The stages below are final, so a StaticProtocolPipeline calls them
+	 * without virtual dispatch.
+	 */
+	class IProtocolStage
+	{
+	public:
+		virtual ~IProtocolStage() = default;
+
+		/**
+		 * @brief Gets the most bytes encode() adds to a frame.
+		 */
+		virtual size_t overhead() const { return 0; }
+
+		/**
+		 * @brief Transforms a frame for sending.
+		 *
+		 * @param frame The frame; capacity leaves at least overhead() bytes of room.
+		 */
+		virtual void encode(FrameBuffer &frame) const = 0;
+
+		/**
+		 * @brief Reverses encode() on a received frame.
+		 *
+		 * @param frame The frame.
+		 *
+		 * @throws std::runtime_error If the frame was not produced by encode().
+		 */
+		virtual void decode(FrameBuffer &frame) const = 0;
+	};
+
+	/**
+	 * @class ShiftStage
+	 * @brief Adds a constant to every payload byte; the stage form of ShiftProtocol.
+	 */
+	class ShiftStage final : public IProtocolStage
+	{
+	public:
+		explicit ShiftStage(uint16_t charShift) : m_shift(static_cast<uint8_t>(charShift)) {}
+
+		void encode(FrameBuffer &frame) const override
+		{
+			auto payload = frame.payload();
+			add_bytes(payload.data(), payload.data(), payload.size(), m_shift);
+		}
+
+		void decode(FrameBuffer &frame) const override
+		{
+			auto payload = frame.payload();
+			add_bytes(payload.data(), payload.data(), payload.size(), static_cast<uint8_t>(-m_shift));
+		}
+
+	private:
+		/// @brief Byte added to each payload byte when encoding.
+		uint8_t m_shift;
+	};
+
+	/**
+	 * @class SubstitutionStage
+	 * @brief Maps every payload byte through a permutation; the stage form of SubstitutionProtocol.
+	 */
+	class SubstitutionStage final : public IProtocolStage
+	{
+	public:
+		/**
+		 * @param table Encoding table; every byte value must appear exactly once.
+		 *
+		 * @throws std::invalid_argument If table is not a permutation.
+		 */
+		explicit SubstitutionStage(const ByteTable &table);
+
+		void encode(FrameBuffer &frame) const override
+		{
+			auto payload = frame.payload();
+			substitute_bytes(payload.data(), payload.data(), payload.size(), m_encode);
+		}
+
+		void decode(FrameBuffer &frame) const override
+		{
+			auto payload = frame.payload();
+			substitute_bytes(payload.data(), payload.data(), payload.size(), m_decode);
+		}
+
+	private:
+		/// @brief Table applied when encoding.
+		SubstitutionTable m_encode;
+		/// @brief Inverse of m_encode, applied when decoding.
+		SubstitutionTable m_decode;
+	};
+
+	/**
+	 * @class ChecksumStage
+	 * @brief Appends a CRC over the whole frame; the stage form of ChecksumProtocol.
+	 */
+	class ChecksumStage final : public IProtocolStage
+	{
+	public:
+		explicit ChecksumStage(ChecksumType type = ChecksumType::Crc32C) : m_type(type) {}
+
+		size_t overhead() const override { return m_type == ChecksumType::Crc16Ccitt ? 2 : 4; }
+
+		void encode(FrameBuffer &frame) const override
+		{
+			size_t covered = frame.size;
+			frame.resize(covered + overhead());
+
+			uint32_t checksum = compute(frame.data, covered);
+			for (size_t i = 0; i < overhead(); ++i)
+			{
+				frame.data[covered + i] = static_cast<char>(checksum >> (8 * (overhead() - 1 - i)));
+			}
+		}
+
+		/**
+		 * @throws transport::ChecksumException If the checksum does not match.
+		 */
+		void decode(FrameBuffer &frame) const override
+		{
+			if (frame.size < MessageView::PREAMBLE_SIZE + overhead())
+				throw std::runtime_error("Frame too short for its checksum");
+
+			size_t covered = frame.size - overhead();
+			uint32_t received = 0;
+			for (size_t i = 0; i < overhead(); ++i)
+			{
+				received = (received << 8) | static_cast<uint8_t>(frame.data[covered + i]);
+			}
+
+			if (received != compute(frame.data, covered))
+				throw wm::transport::ChecksumException();
+
+			frame.resize(covered);
+		}
+
+	private:
+		uint32_t compute(const char *data, size_t size) const
+		{
+			return m_type == ChecksumType::Crc16Ccitt ? crc16_ccitt(data, size) : crc32c(data, size);
+		}
+
+		/// @brief The checksum appended and verified.
+		ChecksumType m_type;
+	};
+}
@@ -39,14 +39,15 @@ namespace wm::protoc
 		/**
 		 * @brief Encodes a message with character shift encoding.
 		 * 
-		 * Serializes the message and then shifts each byte by the configured
-		 * shift amount.
+		 * Serializes the message into out and then shifts the payload in place
+		 * with the vectorized add_bytes kernel.
 		 * 
 		 * @param mes The Message to encode.
+		 * @param out Destination buffer.
 		 * 
-		 * @return The encoded message bytes (shifted).
+		 * @return Number of bytes written.
 		 */
-		std::vector<char> encode(const Message &mes) override;
+		size_t encodeInto(const Message &mes, std::span<char> out) override;
 		
 		/**
 		 * @brief Decodes a shift-encoded message buffer.
@@ -60,25 +61,22 @@ namespace wm::protoc
 		 * @return The decoded Message object.
 		 */
 		Message decode(const char *data, size_t size) override;
-	private:
 
 		/**
-		 * @brief Encodes a single byte using the shift transformation.
-		 * 
-		 * @param byte The byte to encode.
-		 * 
-		 * @return The encoded byte.
-		 */
-		char encodeByte(const char byte);
-		
-		/**
-		 * @brief Decodes a single byte using the reverse shift transformation.
+		 * @brief Unshifts the payload of one frame into a stack buffer and yields it.
 		 * 
-		 * @param byte The encoded byte to decode.
+		 * @param data One shift-encoded message.
+		 * @param on_message Called with the decoded message.
 		 * 
-		 * @return The decoded byte.
+		 * @return Always 1.
 		 */
-		char decodeByte(const char byte);
+		size_t feed(std::span<const char> data, const MessageSink &on_message) override;
+	private:
+		/// @brief Byte added to each payload byte when encoding.
+		uint8_t encodeDelta() const { return static_cast<uint8_t>(charShift); }
+
+		/// @brief Byte added to each payload byte when decoding.
+		uint8_t decodeDelta() const { return static_cast<uint8_t>(-charShift); }
 
 	private:
 		/// @brief The shift amount for encoding/decoding.
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "IProtocolAdapter.hpp"
+#include "ByteKernels.hpp"
+#include <cstdint>
+
+namespace wm::protoc
+{
+	/**
+	 * @class SubstitutionProtocol
+	 * @brief Protocol implementation that maps each payload byte through a table.
+	 * 
+	 * Generalizes ShiftProtocol to any byte permutation: the sender replaces
+	 * each payload byte b with table[b] and the receiver applies the inverse
+	 * table. The message header is left untouched, as in ShiftProtocol.
+	 * 
+	 * Both directions run in place with the vectorized substitute_bytes kernel.
+	 * 
+	 * @note Like ShiftProtocol this is a data transformation, not encryption.
+	 */
+	class SubstitutionProtocol : public IProtocolAdapter
+	{
+	public:
+		/**
+		 * @brief Constructs a SubstitutionProtocol from an encoding table.
+		 * 
+		 * @param table Encoding table; every byte value must appear exactly once.
+		 * 
+		 * @throws std::invalid_argument If table is not a permutation.
+		 */
+		explicit SubstitutionProtocol(const ByteTable &table);
+
+		/**
+		 * @brief Destructor.
+		 */
+		~SubstitutionProtocol() override = default;
+
+		/**
+		 * @brief Serializes the message into out and substitutes its payload in place.
+		 * 
+		 * @param mes The Message to encode.
+		 * @param out Destination buffer.
+		 * 
+		 * @return Number of bytes written.
+		 */
+		size_t encodeInto(const Message &mes, std::span<char> out) override;
+
+		/**
+		 * @brief Deserializes a message and maps its payload back through the inverse table.
+		 * 
+		 * @param data Pointer to the encoded message buffer.
+		 * @param size The length of the buffer in bytes.
+		 * 
+		 * @return The decoded Message object.
+		 */
+		Message decode(const char *data, size_t size) override;
+
+		/**
+		 * @brief Decodes the payload of one frame into a stack buffer and yields it.
+		 * 
+		 * @param data One encoded message.
+		 * @param on_message Called with the decoded message.
+		 * 
+		 * @return Always 1.
+		 */
+		size_t feed(std::span<const char> data, const MessageSink &on_message) override;
+
+	private:
+		/// @brief Table applied when encoding.
+		SubstitutionTable m_encode;
+		/// @brief Inverse of m_encode, applied when decoding.
+		SubstitutionTable m_decode;
+	};
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "LengthPrefixFramer.hpp"
+#include "RingBuffer.hpp"
+#include "../protocols/Cobs.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class CobsFramer
+	 * @brief Splits a received byte stream into COBS-encoded, 0x00-delimited frames.
+	 *
+	 * Each frame on the wire is a length-prefixed frame (see LengthPrefixFramer)
+	 * COBS or COBS/R encoded and followed by a 0x00 delimiter. Since 0x00 never
+	 * occurs inside an encoded frame, the framer finds frame ends with memchr()
+	 * (vectorized in the C library) and a corrupted frame costs only itself.
+	 *
+	 * Frames are decoded in place in the ring, so callbacks see exactly what
+	 * they would without stuffing, without a copy.
+	 */
+	class CobsFramer
+	{
+	public:
+		/// @brief Frame delimiter.
+		static constexpr char DELIMITER = 0;
+		/// @brief Room reserved ahead of a frame so it can be encoded in place.
+		static constexpr size_t HEADER_SIZE = protoc::cobs_max_overhead(LengthPrefixFramer::MAX_FRAME_SIZE);
+		/// @brief Bytes written after each encoded frame.
+		static constexpr size_t TRAILER_SIZE = 1;
+		/// @brief Largest frame on the wire, including overhead and delimiter.
+		static constexpr size_t MAX_FRAME_SIZE = HEADER_SIZE + LengthPrefixFramer::MAX_FRAME_SIZE + TRAILER_SIZE;
+
+		explicit CobsFramer(protoc::CobsVariant variant = protoc::CobsVariant::Cobs) : m_variant(variant) {}
+
+		/**
+		 * @brief Encodes a frame in place and appends the delimiter.
+		 *
+		 * @param buffer Holds the frame at buffer + HEADER_SIZE and room for TRAILER_SIZE after it.
+		 * @param length Frame length, at most LengthPrefixFramer::MAX_FRAME_SIZE.
+		 *
+		 * @return Number of wire bytes, starting at buffer.
+		 */
+		size_t encodeInPlace(char *buffer, size_t length) const
+		{
+			size_t encoded = protoc::cobs_encode(buffer + HEADER_SIZE, length, buffer, m_variant);
+			buffer[encoded] = DELIMITER;
+			return encoded + TRAILER_SIZE;
+		}
+
+		/**
+		 * @brief Encodes a frame into out and appends the delimiter.
+		 *
+		 * @param out Destination, at least MAX_FRAME_SIZE bytes.
+		 * @param data Frame bytes.
+		 * @param length Frame length, at most LengthPrefixFramer::MAX_FRAME_SIZE.
+		 *
+		 * @return Number of wire bytes written.
+		 */
+		size_t encode(char *out, const char *data, size_t length) const
+		{
+			size_t encoded = protoc::cobs_encode(data, length, out, m_variant);
+			out[encoded] = DELIMITER;
+			return encoded + TRAILER_SIZE;
+		}
+
+		/**
+		 * @brief Extracts all complete frames currently stored in the ring.
+		 *
+		 * Frames that fail to decode or whose length byte does not match are
+		 * dropped up to their delimiter. Frames that straddle the wrap point of
+		 * the ring are made contiguous before being decoded.
+		 *
+		 * @tparam F Callable with signature void(const char *frame, size_t length).
+		 * @param ring The ring buffer holding received bytes; consumed frames are removed.
+		 * @param on_frame Callback invoked for each decoded frame.
+		 *
+		 * @return Number of frames extracted.
+		 */
+		template <typename F>
+		size_t extract(RingBuffer &ring, F &&on_frame)
+		{
+			size_t frames = 0;
+
+			while (!ring.empty())
+			{
+				auto data = ring.readable();
+				bool wrapped = data.size() != ring.size();
+				size_t consumed = 0;
+
+				while (consumed < data.size())
+				{
+					char *frame = data.data() + consumed;
+					size_t remaining = data.size() - consumed;
+
+					const void *delimiter = std::memchr(frame, DELIMITER, remaining);
+					if (delimiter == nullptr)
+					{
+						if (remaining > MAX_FRAME_SIZE - TRAILER_SIZE)
+						{
+							// Too long to be a frame: drop it and the rest up to the next delimiter.
+							loseSync(remaining);
+							consumed += remaining;
+							m_skipping = true;
+						}
+						break;
+					}
+
+					size_t encoded = static_cast<const char *>(delimiter) - frame;
+					consumed += encoded + TRAILER_SIZE;
+
+					if (m_skipping)
+					{
+						loseSync(encoded + TRAILER_SIZE);
+						m_skipping = false;
+						continue;
+					}
+					if (encoded == 0)
+					{
+						// Back-to-back delimiters, e.g. a peer flushing the line.
+						continue;
+					}
+
+					auto decoded = protoc::cobs_decode(frame, encoded, m_variant);
+					if (!decoded || *decoded < 1 + LengthPrefixFramer::MIN_LENGTH ||
+						*decoded != 1 + static_cast<size_t>(static_cast<uint8_t>(frame[0])))
+					{
+						loseSync(encoded + TRAILER_SIZE);
+						continue;
+					}
+
+					on_frame(frame, *decoded);
+					m_in_sync = true;
+					++frames;
+				}
+
+				ring.consume(consumed);
+
+				if (!wrapped)
+				{
+					break;
+				}
+
+				ring.linearize();
+			}
+
+			return frames;
+		}
+
+		/**
+		 * @brief Gets the number of bytes discarded with invalid frames.
+		 *
+		 * @return Dropped byte count since construction.
+		 */
+		size_t droppedBytes() const { return m_dropped_bytes; }
+
+		/**
+		 * @brief Gets how many times the stream lost synchronization.
+		 *
+		 * @return Number of times valid frames were followed by invalid ones.
+		 */
+		size_t syncLosses() const { return m_sync_losses; }
+
+	private:
+		/// @brief Accounts for dropped bytes and counts the first drop after a valid frame.
+		void loseSync(size_t dropped)
+		{
+			m_dropped_bytes += dropped;
+			if (m_in_sync && dropped > 0)
+			{
+				++m_sync_losses;
+				m_in_sync = false;
+			}
+		}
+
+		/// @brief COBS or COBS/R, must match the peer.
+		protoc::CobsVariant m_variant;
+		/// @brief Bytes dropped with invalid or oversized frames.
+		size_t m_dropped_bytes{0};
+		/// @brief Times synchronization was lost.
+		size_t m_sync_losses{0};
+		/// @brief Whether the last frame examined was valid.
+		bool m_in_sync{false};
+		/// @brief Dropping an oversized frame until its delimiter arrives.
+		bool m_skipping{false};
+	};
+}
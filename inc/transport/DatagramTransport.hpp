@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "ITransport.hpp"
+
+#include <sys/socket.h>
+
+namespace wm::transport
+{
+	/**
+	 * @class DatagramTransport
+	 * @brief UDP transport carrying exactly one frame per datagram.
+	 *
+	 * Datagram boundaries are the frame boundaries, so no stream framer is
+	 * involved: each received datagram is decoded in place and handed to the
+	 * receive subscribers. The receive thread pulls up to batch_size datagrams
+	 * per recvmmsg() call into buffers allocated once at construction, and
+	 * sendBatch() pushes many frames with sendmmsg(). The socket receive buffer
+	 * (rcvbuf_size) is the only receive queue; inline subscribers run on the
+	 * receive thread, the others on the threads of their DispatchMode.
+	 *
+	 * With DatagramConfig::timestamps set, each delivered message carries the
+	 * kernel receive time of its datagram in kernel_rx_timestamp.
+	 */
+	class DatagramTransport : public ITransport
+	{
+	public:
+		/// @brief Largest datagram accepted; longer ones cannot hold a valid frame.
+		static constexpr size_t MAX_DATAGRAM_SIZE = MessageView::MAX_SIZE;
+
+		/**
+		 * @brief Constructs a datagram transport.
+		 *
+		 * @param datagram_config Local and remote endpoints and socket options.
+		 * @param config Timeouts; port is replaced by a description of the endpoints.
+		 */
+		DatagramTransport(const DatagramConfig &datagram_config, const SerialConfig &config = SerialConfig());
+
+		/**
+		 * @brief Destructor that closes the socket if open.
+		 */
+		~DatagramTransport() override;
+
+		DatagramTransport(const DatagramTransport &) = delete;
+		DatagramTransport &operator=(const DatagramTransport &) = delete;
+
+		/**
+		 * @brief Binds (and, with a remote port, connects) the socket and starts the receive thread.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode open() override;
+
+		/**
+		 * @brief Stops the receive thread and closes the socket.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode close() override;
+
+		/**
+		 * @brief Sends one frame as one datagram to the remote endpoint.
+		 *
+		 * @param data Pointer to the frame.
+		 * @param length Size of the frame in bytes.
+		 *
+		 * @return Number of bytes sent, or -1 on error.
+		 *
+		 * @throws PortException If the transport is not open, has no remote endpoint or the frame is too large.
+		 */
+		int send(const char *data, size_t length) override;
+
+		/**
+		 * @brief Encodes a frame on the stack and sends it without allocating.
+		 *
+		 * @param max_length Upper bound on the number of bytes the writer produces.
+		 * @param writer Callable writing the frame and returning its actual size.
+		 *
+		 * @return Number of bytes sent, or -1 on error.
+		 */
+		int sendInPlace(size_t max_length, const FrameWriter &writer) override;
+
+		/**
+		 * @brief Sends several frames, one datagram each, with as few sendmmsg() calls as possible.
+		 *
+		 * @param frames The frames to send.
+		 *
+		 * @return Number of frames sent, or -1 if none could be sent.
+		 *
+		 * @throws PortException If the transport is not open, has no remote endpoint or
+		 *         any frame is too large; nothing is sent then.
+		 */
+		int sendBatch(std::span<const std::span<const char>> frames);
+
+		/**
+		 * @brief Reads the next datagram directly, bypassing the receive thread.
+		 *
+		 * @param buffer Pointer to the buffer where the datagram will be stored.
+		 * @param length Size of buffer.
+		 *
+		 * @return Number of bytes received, 0 if none is pending, or -1 on error.
+		 */
+		int receive(char *buffer, size_t length) override;
+
+		/**
+		 * @brief Gets the size of the next pending datagram.
+		 *
+		 * @return Number of available bytes.
+		 */
+		int available() const override;
+
+		/**
+		 * @brief Gets the current configuration.
+		 *
+		 * @return A copy of the SerialConfig in use.
+		 */
+		SerialConfig get_config() const override
+		{
+			return m_config;
+		}
+
+		/**
+		 * @brief Gets the local port the socket is bound to.
+		 *
+		 * @return The port, or 0 if not open.
+		 */
+		uint16_t localPort() const;
+
+		/**
+		 * @brief Gets the number of datagrams dropped because they did not hold a valid frame.
+		 *
+		 * @return Dropped datagram count since construction.
+		 */
+		uint64_t droppedDatagrams() const
+		{
+			return m_dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		/**
+		 * @brief Main loop for the receive thread.
+		 */
+		void receiveThread();
+
+		/**
+		 * @brief Receives every pending datagram in batches and notifies subscribers.
+		 *
+		 * @return false on a socket error.
+		 */
+		bool drain();
+
+		/**
+		 * @brief Creates, binds and connects the socket.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode openSocket();
+
+		/// @brief Endpoints and socket options.
+		DatagramConfig m_datagram_config;
+		/// @brief Socket descriptor (-1 if not open).
+		int m_fd{-1};
+		/// @brief eventfd used to wake the receive thread on close.
+		int m_wake_fd{-1};
+		/// @brief Whether the socket is connected to a remote endpoint.
+		bool m_connected{false};
+		/// @brief The receive thread object.
+		std::thread m_thread;
+
+		/// @brief Datagram payload storage, batch_size slots of MAX_DATAGRAM_SIZE + 1 bytes.
+		std::vector<char> m_rx_storage;
+		/// @brief Control message storage for the timestamps, one slot per datagram.
+		std::vector<char> m_rx_control;
+		std::vector<struct iovec> m_rx_iov;
+		std::vector<struct mmsghdr> m_rx_headers;
+		/// @brief Datagrams that failed to decode.
+		std::atomic<uint64_t> m_dropped{0};
+
+		/// @brief Serializes senders sharing the batch headers.
+		std::mutex mtxTransmit;
+		std::vector<struct iovec> m_tx_iov;
+		std::vector<struct mmsghdr> m_tx_headers;
+	};
+}
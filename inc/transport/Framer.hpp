@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "CobsFramer.hpp"
+#include "LengthPrefixFramer.hpp"
+#include "SyncMarkerFramer.hpp"
+#include "TransportTypes.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class Framer
+	 * @brief Stream framer selected by SerialConfig::framing.
+	 *
+	 * Dispatches to LengthPrefixFramer, SyncMarkerFramer or CobsFramer with a
+	 * branch rather than a virtual call, so the frame callback stays inlined in
+	 * every mode.
+	 *
+	 * On the send side a frame is either written behind headerSize() bytes of
+	 * room and completed in place with finish(), or copied with writeFrame().
+	 */
+	class Framer
+	{
+	public:
+		/// @brief Largest frame on the wire in any mode, including headers.
+		static constexpr size_t MAX_FRAME_SIZE = std::max(SyncMarkerFramer::MAX_FRAME_SIZE, CobsFramer::MAX_FRAME_SIZE);
+		/// @brief Largest headerSize() in any mode.
+		static constexpr size_t MAX_HEADER_SIZE = std::max(SyncMarkerFramer::HEADER_SIZE, CobsFramer::HEADER_SIZE);
+
+		explicit Framer(FramingMode mode = FramingMode::LengthPrefix)
+			: m_mode(mode),
+			  m_cobs(mode == FramingMode::CobsR ? protoc::CobsVariant::CobsR : protoc::CobsVariant::Cobs)
+		{
+		}
+
+		/**
+		 * @brief Extracts all complete frames currently stored in the ring.
+		 *
+		 * @tparam F Callable with signature void(const char *frame, size_t length).
+		 * @param ring The ring buffer holding received bytes; consumed frames are removed.
+		 * @param on_frame Callback invoked with each length-prefixed frame.
+		 *
+		 * @return Number of frames extracted.
+		 */
+		template <typename F>
+		size_t extract(RingBuffer &ring, F &&on_frame)
+		{
+			if (m_mode == FramingMode::SyncMarker)
+			{
+				return m_sync_marker.extract(ring, on_frame);
+			}
+			if (isCobs())
+			{
+				return m_cobs.extract(ring, on_frame);
+			}
+			return m_length_prefix.extract(ring, on_frame);
+		}
+
+		/**
+		 * @brief Gets the room a frame needs ahead of it to be completed by finish().
+		 *
+		 * @return 0 for LengthPrefix, SyncMarkerFramer::HEADER_SIZE or CobsFramer::HEADER_SIZE.
+		 */
+		size_t headerSize() const
+		{
+			if (m_mode == FramingMode::SyncMarker)
+			{
+				return SyncMarkerFramer::HEADER_SIZE;
+			}
+			return isCobs() ? CobsFramer::HEADER_SIZE : 0;
+		}
+
+		/**
+		 * @brief Gets the room a frame needs after it to be completed by finish().
+		 *
+		 * @return CobsFramer::TRAILER_SIZE in the COBS modes, otherwise 0.
+		 */
+		size_t trailerSize() const { return isCobs() ? CobsFramer::TRAILER_SIZE : 0; }
+
+		/**
+		 * @brief Gets the most bytes a frame of length bytes takes on the wire.
+		 *
+		 * @param length Frame length.
+		 *
+		 * @return headerSize() + length + trailerSize().
+		 */
+		size_t maxWireSize(size_t length) const { return headerSize() + length + trailerSize(); }
+
+		/**
+		 * @brief Checks whether a frame can be sent in this mode.
+		 *
+		 * @param length Frame length.
+		 *
+		 * @return false for frames too long to COBS-encode in place; any length otherwise.
+		 */
+		bool accepts(size_t length) const
+		{
+			return !isCobs() || length <= LengthPrefixFramer::MAX_FRAME_SIZE;
+		}
+
+		/**
+		 * @brief Turns a frame written at buffer + headerSize() into wire bytes in place.
+		 *
+		 * @param buffer Start of the reserved header room; the frame is followed by trailerSize() bytes of room.
+		 * @param length Frame length, accepted by accepts().
+		 *
+		 * @return Number of wire bytes, starting at buffer; at most maxWireSize(length).
+		 */
+		size_t finish(char *buffer, size_t length) const
+		{
+			if (m_mode == FramingMode::SyncMarker)
+			{
+				SyncMarkerFramer::writeHeader(buffer, buffer[SyncMarkerFramer::HEADER_SIZE]);
+				return SyncMarkerFramer::HEADER_SIZE + length;
+			}
+			if (isCobs())
+			{
+				return m_cobs.encodeInPlace(buffer, length);
+			}
+			return length;
+		}
+
+		/**
+		 * @brief Writes the wire bytes of a frame through a sink.
+		 *
+		 * @tparam W Callable with signature void(const char *data, size_t length), called once or twice.
+		 * @param data Frame bytes.
+		 * @param length Frame length, accepted by accepts().
+		 * @param write Sink receiving the wire bytes in order.
+		 *
+		 * @return Number of wire bytes written; at most maxWireSize(length).
+		 */
+		template <typename W>
+		size_t writeFrame(const char *data, size_t length, W &&write) const
+		{
+			if (isCobs())
+			{
+				char wire[CobsFramer::MAX_FRAME_SIZE];
+				size_t wire_length = m_cobs.encode(wire, data, length);
+				write(wire, wire_length);
+				return wire_length;
+			}
+
+			size_t header = headerSize();
+			if (header > 0)
+			{
+				char frame_header[SyncMarkerFramer::HEADER_SIZE];
+				SyncMarkerFramer::writeHeader(frame_header, data[0]);
+				write(frame_header, header);
+			}
+			write(data, length);
+			return header + length;
+		}
+
+		/**
+		 * @brief Gets the number of bytes discarded while looking for frames.
+		 *
+		 * @return Dropped byte count since construction.
+		 */
+		size_t droppedBytes() const
+		{
+			return m_length_prefix.droppedBytes() + m_sync_marker.droppedBytes() + m_cobs.droppedBytes();
+		}
+
+		/**
+		 * @brief Gets how many times the stream lost synchronization.
+		 *
+		 * @return Sync losses in SyncMarker and COBS modes, always 0 for LengthPrefix.
+		 */
+		size_t syncLosses() const { return m_sync_marker.syncLosses() + m_cobs.syncLosses(); }
+
+		FramingMode mode() const { return m_mode; }
+
+	private:
+		bool isCobs() const { return m_mode == FramingMode::Cobs || m_mode == FramingMode::CobsR; }
+
+		FramingMode m_mode;
+		LengthPrefixFramer m_length_prefix;
+		SyncMarkerFramer m_sync_marker;
+		CobsFramer m_cobs;
+	};
+}
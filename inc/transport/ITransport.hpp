@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <string>
 #include <thread> 
+#include <atomic>
 
 
 #include <fcntl.h>
@@ -10,8 +11,12 @@
 #include <unistd.h>
 
 #include "TransportTypes.hpp"
+#include "ReceiveDispatcher.hpp"
 #include <functional>
+#include <future>
+#include <memory>
 #include "../messages/Message.hpp"
+#include "../protocols/IProtocolAdapter.hpp"
 
 using namespace wm::messages;
 
@@ -35,7 +40,8 @@ namespace wm::transport {
 		 * 
 		 * @param config Reference to a SerialConfig struct containing transport settings.
 		 */
-		ITransport(const SerialConfig& config) : m_config(config) {};
+		ITransport(const SerialConfig& config)
+			: m_config(config), m_dispatcher(config.dispatch_pool_size, config.dispatch_thread) {};
 
 		/**
 		 * @brief Virtual destructor.
@@ -98,6 +104,57 @@ namespace wm::transport {
 			return send(data.data(), data.size());
 		}
 
+		/**
+		 * @brief Sends a frame produced directly into the transport's buffer.
+		 * 
+		 * Lets callers encode into transmit storage instead of building a
+		 * temporary buffer. The default implementation encodes into a scratch
+		 * buffer and calls send().
+		 * 
+		 * @param max_length Upper bound on the number of bytes the writer produces.
+		 * @param writer Callable writing the frame and returning its actual size.
+		 * 
+		 * @return Number of bytes successfully sent, or negative value on error.
+		 */
+		virtual int sendInPlace(size_t max_length, const FrameWriter& writer) {
+			ByteBuffer buffer(max_length);
+			size_t length = writer(buffer);
+			return send(buffer.data(), length);
+		}
+
+		/**
+		 * @brief Sends data and reports completion through a callback.
+		 * 
+		 * The default implementation sends synchronously and invokes the callback
+		 * before returning. Transports with a dedicated writer override this to
+		 * queue the data and complete it from the writer thread.
+		 * 
+		 * @param data Pointer to the data buffer to send.
+		 * @param length The number of bytes to send.
+		 * @param on_complete Callback receiving the bytes written or a negative error value.
+		 */
+		virtual void sendAsync(const char* data, size_t length, SendCallback on_complete) {
+			int result = send(data, length);
+			if (on_complete) {
+				on_complete(result);
+			}
+		}
+
+		/**
+		 * @brief Sends data and returns a future completed once it is written.
+		 * 
+		 * @param data Pointer to the data buffer to send.
+		 * @param length The number of bytes to send.
+		 * 
+		 * @return Future holding the bytes written or a negative error value.
+		 */
+		std::future<int> sendAsync(const char* data, size_t length) {
+			auto promise = std::make_shared<std::promise<int>>();
+			auto result = promise->get_future();
+			sendAsync(data, length, [promise](int status) { promise->set_value(status); });
+			return result;
+		}
+
 		/**
 		 * @brief Receives data into a buffer.
 		 * 
@@ -166,13 +223,95 @@ namespace wm::transport {
 		 * @brief Subscribes to receive notifications.
 		 * 
 		 * Registers a callback function that will be invoked whenever a message
-		 * is received on the transport.
+		 * is received on the transport. The view references the transport's
+		 * receive buffer and is only valid during the call; use
+		 * MessageView::toOwned() to keep the message.
+		 * 
+		 * By default the callback runs inline on the receive path, so a slow
+		 * handler delays every later frame; options.mode moves it to the shared
+		 * worker pool or to a thread of its own. options.type and the index and
+		 * payload filters limit it to the messages it handles. Subscribing and
+		 * unsubscribing are allowed while the transport is open.
+		 * 
+		 * @param callback A function that takes a const MessageView& parameter.
+		 * @param options Executor, filter, name and queue limit of the subscription.
+		 * 
+		 * @return Handle that unsubscribes the callback when destroyed.
+		 */
+		[[nodiscard]] ReceiveSubscription subscribeReceive(std::function<void(const MessageView&)> callback, const SubscribeOptions& options = {})
+		{
+			return m_dispatcher.subscribe(std::move(callback), options);
+		}
+
+		/**
+		 * @brief Subscribes to receive notifications with an owned message copy.
+		 * 
+		 * Convenience overload for subscribers that need a Message; each received
+		 * message is copied out of the receive buffer before the call.
 		 * 
 		 * @param callback A function that takes a const Message& parameter.
+		 * @param options Executor, filter, name and queue limit of the subscription.
+		 * 
+		 * @return Handle that unsubscribes the callback when destroyed.
 		 */
-		void subscribeReceive(std::function<void(const Message&)> callback)
+		[[nodiscard]] ReceiveSubscription subscribeReceive(std::function<void(const Message&)> callback, const SubscribeOptions& options = {})
 		{
-			receive_callbacks.push_back(callback);
+			return m_dispatcher.subscribe([callback = std::move(callback)](const MessageView& view)
+				{ callback(view.toOwned()); }, options);
+		}
+
+		/**
+		 * @brief Gets per-subscriber delivery counters.
+		 * 
+		 * Use it to find the handler that is backing up the link: its queue
+		 * depth, drops and handler time stand out.
+		 * 
+		 * @return One SubscriberStats per subscription, in subscription order.
+		 */
+		std::vector<SubscriberStats> receiveStats() const
+		{
+			return m_dispatcher.stats();
+		}
+
+		/**
+		 * @brief Binds the protocol adapter that decodes received frames.
+		 * 
+		 * Every frame the transport extracts is passed to protocol->feed() on the
+		 * receive path, and subscribers get the decoded messages. Without an
+		 * adapter frames are decoded as plain Message wire format. Must be set
+		 * before open(); the adapter must outlive the open transport.
+		 * 
+		 * @param protocol Adapter to decode with, or nullptr for plain decoding.
+		 */
+		void bindProtocol(protoc::IProtocolAdapter* protocol)
+		{
+			m_protocol = protocol;
+		}
+
+		/**
+		 * @brief Gets the number of received frames dropped for a bad checksum.
+		 * 
+		 * Only adapters that carry a checksum, such as ChecksumProtocol, detect these.
+		 * 
+		 * @return Checksum failures since construction.
+		 */
+		size_t checksumErrors() const
+		{
+			return m_checksum_errors.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Installs a hook receiving the timing of every frame.
+		 * 
+		 * Receive timings are reported after the subscribers return, on the
+		 * thread that calls them; transmit timings on the writer thread once
+		 * the frame has drained. Must be set before open().
+		 * 
+		 * @param hook Callback taking a const FrameTiming&; empty disables timing.
+		 */
+		void setTimingHook(TimingCallback hook)
+		{
+			m_timing_hook = std::move(hook);
 		}
 
 		/**
@@ -182,19 +321,75 @@ namespace wm::transport {
 		 * This method is typically called by the receive mechanism (e.g., receive thread)
 		 * when a complete message is available.
 		 * 
-		 * @param data The received Message to notify subscribers about.
+		 * @param data View of the received message to notify subscribers about.
 		 */
-		void notifyReceive(const Message& data)
+		void notifyReceive(const MessageView& data)
 		{
-			for (const auto& callback : receive_callbacks)
+			if (!m_timing_hook)
 			{
-				callback(data);
+				m_dispatcher.dispatch(data);
+				return;
 			}
+
+			FrameTiming timing;
+			timing.direction = FrameDirection::Rx;
+			timing.length = static_cast<size_t>(data.len) + 1;
+			timing.received = data.rx_timestamp;
+			timing.dispatched = monotonic_now();
+			m_dispatcher.dispatch(data);
+			timing.handled = monotonic_now();
+			m_timing_hook(timing);
 		}
 
 	protected:
-		std::vector<std::function<void(const Message&)>> receive_callbacks;
+		/**
+		 * @brief Decodes one received frame with the bound protocol adapter.
+		 * 
+		 * @tparam F Callable with signature void(const MessageView&).
+		 * @param frame The frame bytes.
+		 * @param received Timestamp stored in each decoded message.
+		 * @param on_message Called with each decoded message; the view is only valid during the call.
+		 * 
+		 * Frames failing the adapter's checksum are counted in checksumErrors()
+		 * and dropped.
+		 * 
+		 * @throws std::runtime_error If the frame cannot be decoded.
+		 */
+		template <typename F>
+		void decodeFrame(std::span<const char> frame, Timestamp received, F&& on_message)
+		{
+			if (m_protocol == nullptr)
+			{
+				MessageView mes = MessageView::decode(frame.data(), frame.size());
+				mes.rx_timestamp = received;
+				on_message(mes);
+				return;
+			}
+
+			try
+			{
+				m_protocol->feed(frame, [&on_message, received](const MessageView& decoded)
+					{
+						MessageView mes = decoded;
+						mes.rx_timestamp = received;
+						on_message(mes);
+					});
+			}
+			catch (const ChecksumException&)
+			{
+				m_checksum_errors.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		/// @brief Optional per-frame timing hook, see setTimingHook().
+		TimingCallback m_timing_hook;
+		/// @brief Adapter decoding received frames, see bindProtocol().
+		protoc::IProtocolAdapter* m_protocol{ nullptr };
+		/// @brief Frames dropped because the adapter's checksum did not match.
+		std::atomic<size_t> m_checksum_errors{ 0 };
 		SerialConfig m_config;
-		ConnectionState m_con_state{ ConnectionState::Closed };
+		std::atomic<ConnectionState> m_con_state{ ConnectionState::Closed };
+		/// @brief Runs receive subscribers on their chosen executors.
+		ReceiveDispatcher m_dispatcher;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#include "TransportTypes.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class IoUring
+	 * @brief Minimal io_uring instance driven through the raw system calls.
+	 *
+	 * Maps the submission and completion rings of one io_uring instance and
+	 * exposes just what the transports need: grabbing a submission entry,
+	 * submitting and waiting in a single io_uring_enter() call, reaping
+	 * completions and registering fixed buffers.
+	 *
+	 * @note Not thread-safe; one thread owns the submission side and reaps completions.
+	 */
+	class IoUring
+	{
+	public:
+		/**
+		 * @brief Creates an io_uring instance.
+		 *
+		 * @param entries Number of submission queue entries (rounded up by the kernel).
+		 *
+		 * @throws TransportException If the kernel refuses to create or map the rings.
+		 */
+		explicit IoUring(unsigned entries);
+
+		/**
+		 * @brief Destructor that unmaps the rings and closes the instance.
+		 */
+		~IoUring();
+
+		IoUring(const IoUring &) = delete;
+		IoUring &operator=(const IoUring &) = delete;
+
+		/**
+		 * @brief Checks whether the running kernel supports the operations the transports use.
+		 *
+		 * Probes once for READ, READ_FIXED, WRITEV, POLL_ADD, TIMEOUT,
+		 * LINK_TIMEOUT and ASYNC_CANCEL and caches the answer.
+		 *
+		 * @return true if io_uring is usable.
+		 */
+		static bool isSupported();
+
+		/**
+		 * @brief Gets a zeroed submission entry to fill in.
+		 *
+		 * The entry is handed to the kernel by the next submitAndWait().
+		 *
+		 * @return The entry, or nullptr if the submission ring is full.
+		 */
+		struct io_uring_sqe *getSqe();
+
+		/**
+		 * @brief Submits all prepared entries and optionally waits for completions.
+		 *
+		 * @param wait_count Number of completions to wait for (0 returns immediately).
+		 *
+		 * @return Number of entries submitted, or a negative errno value.
+		 */
+		int submitAndWait(unsigned wait_count);
+
+		/**
+		 * @brief Hands every available completion to a callback and releases it.
+		 *
+		 * @tparam F Callable with signature void(const io_uring_cqe &).
+		 * @param on_completion Callback invoked for each completion, oldest first.
+		 *
+		 * @return Number of completions reaped.
+		 */
+		template <typename F>
+		unsigned forEachCompletion(F &&on_completion)
+		{
+			unsigned head = *m_cq_head;
+			unsigned tail = std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+			unsigned count = 0;
+
+			while (head != tail)
+			{
+				on_completion(m_cqes[head & m_cq_mask]);
+				++head;
+				++count;
+			}
+
+			std::atomic_ref<unsigned>(*m_cq_head).store(head, std::memory_order_release);
+			return count;
+		}
+
+		/**
+		 * @brief Registers buffers for IORING_OP_READ_FIXED / WRITE_FIXED.
+		 *
+		 * @param buffers Array of buffers to pin.
+		 * @param count Number of entries in buffers.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode registerBuffers(const struct iovec *buffers, unsigned count);
+
+	private:
+		/// @brief The io_uring instance descriptor.
+		int m_ring_fd{-1};
+
+		/// @brief Mapping holding the submission ring (and the completion ring with IORING_FEAT_SINGLE_MMAP).
+		void *m_sq_map{nullptr};
+		size_t m_sq_map_size{0};
+		/// @brief Mapping holding the completion ring, or nullptr when shared with m_sq_map.
+		void *m_cq_map{nullptr};
+		size_t m_cq_map_size{0};
+		/// @brief Mapping holding the submission entries.
+		struct io_uring_sqe *m_sqes{nullptr};
+		size_t m_sqes_size{0};
+
+		unsigned *m_sq_head{nullptr};
+		unsigned *m_sq_tail{nullptr};
+		unsigned *m_sq_array{nullptr};
+		unsigned m_sq_mask{0};
+		unsigned m_sq_entries{0};
+		/// @brief Local submission tail, published to the kernel by submitAndWait().
+		unsigned m_sqe_tail{0};
+
+		unsigned *m_cq_head{nullptr};
+		unsigned *m_cq_tail{nullptr};
+		unsigned m_cq_mask{0};
+		struct io_uring_cqe *m_cqes{nullptr};
+
+		/**
+		 * @brief Unmaps the rings and closes the descriptor.
+		 */
+		void release();
+	};
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RingBuffer.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class LengthPrefixFramer
+	 * @brief Splits a received byte stream into length-prefixed frames.
+	 *
+	 * Each frame starts with a length byte counting the type, index and payload
+	 * bytes that follow it (see Message). The framer walks the bytes stored in a
+	 * RingBuffer, hands every complete frame to a callback without copying it and
+	 * leaves a trailing partial frame in the buffer for the next read.
+	 */
+	class LengthPrefixFramer
+	{
+	public:
+		/// @brief Smallest valid length byte (type + 32-bit index).
+		static constexpr uint8_t MIN_LENGTH = 5;
+		/// @brief Largest frame on the wire, including the length byte.
+		static constexpr size_t MAX_FRAME_SIZE = 255;
+
+		/**
+		 * @brief Extracts all complete frames currently stored in the ring.
+		 *
+		 * Invalid length bytes are skipped one at a time. Frames that straddle the
+		 * wrap point of the ring are made contiguous before being reported.
+		 *
+		 * @tparam F Callable with signature void(const char *frame, size_t length).
+		 * @param ring The ring buffer holding received bytes; consumed frames are removed.
+		 * @param on_frame Callback invoked for each complete frame.
+		 *
+		 * @return Number of frames extracted.
+		 */
+		template <typename F>
+		size_t extract(RingBuffer &ring, F &&on_frame)
+		{
+			size_t frames = 0;
+
+			while (!ring.empty())
+			{
+				auto data = ring.readable();
+				bool wrapped = data.size() != ring.size();
+				size_t consumed = 0;
+
+				while (consumed < data.size())
+				{
+					uint8_t length = static_cast<uint8_t>(data[consumed]);
+					if (length < MIN_LENGTH || length > MAX_FRAME_SIZE - 1)
+					{
+						++m_dropped_bytes;
+						++consumed;
+						continue;
+					}
+
+					size_t frame_size = 1 + static_cast<size_t>(length);
+					if (data.size() - consumed < frame_size)
+					{
+						break;
+					}
+
+					on_frame(data.data() + consumed, frame_size);
+					consumed += frame_size;
+					++frames;
+				}
+
+				ring.consume(consumed);
+
+				if (!wrapped)
+				{
+					break;
+				}
+
+				ring.linearize();
+			}
+
+			return frames;
+		}
+
+		/**
+		 * @brief Gets the number of bytes discarded because of invalid length bytes.
+		 *
+		 * @return Dropped byte count since construction.
+		 */
+		size_t droppedBytes() const { return m_dropped_bytes; }
+
+	private:
+		/// @brief Bytes skipped while searching for a valid length byte.
+		size_t m_dropped_bytes{0};
+	};
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "ITransport.hpp"
+#include "Framer.hpp"
+#include "RingBuffer.hpp"
+#include "SpscQueue.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class MemoryTransport
+	 * @brief In-process transport whose endpoints are connected by lock-free byte rings.
+	 *
+	 * MemoryTransport endpoints come in pairs created by createPair(): bytes sent
+	 * on one endpoint are framed and delivered to the subscribers of the other,
+	 * exactly as if they had crossed a serial line, but without system calls or
+	 * external processes. Each direction is a single-producer/single-consumer
+	 * byte ring; sends are serialized per endpoint so any number of threads may
+	 * send.
+	 *
+	 * With Delivery::Thread each endpoint runs a receive thread that frames and
+	 * dispatches incoming bytes. With Delivery::Manual nothing is delivered until
+	 * the owner calls poll(), which makes runs fully deterministic.
+	 */
+	class MemoryTransport : public ITransport
+	{
+	public:
+		/**
+		 * @enum Delivery
+		 * @brief Selects who frames and dispatches received bytes.
+		 */
+		enum class Delivery
+		{
+			Thread, ///< A receive thread per endpoint.
+			Manual, ///< The owner calls poll().
+		};
+
+		/// @brief A connected pair of endpoints.
+		using Pair = std::pair<std::unique_ptr<MemoryTransport>, std::unique_ptr<MemoryTransport>>;
+
+		/**
+		 * @brief Creates two connected endpoints.
+		 *
+		 * Each direction holds rx_buffer_size bytes; sends block for up to
+		 * write_timeout_ms while the peer's ring is full.
+		 *
+		 * @param config Configuration shared by both endpoints.
+		 * @param delivery How received bytes are delivered.
+		 *
+		 * @return The two endpoints, not yet opened.
+		 */
+		static Pair createPair(const SerialConfig &config = SerialConfig(), Delivery delivery = Delivery::Thread);
+
+		/**
+		 * @brief Destructor that closes the endpoint if open.
+		 */
+		~MemoryTransport() override;
+
+		MemoryTransport(const MemoryTransport &) = delete;
+		MemoryTransport &operator=(const MemoryTransport &) = delete;
+
+		/**
+		 * @brief Opens the endpoint, discarding bytes sent to it while closed.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode open() override;
+
+		/**
+		 * @brief Closes the endpoint and stops its receive thread.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode close() override;
+
+		/**
+		 * @brief Copies data into the peer's receive ring.
+		 *
+		 * @param data Pointer to the data buffer to send.
+		 * @param length Number of bytes to send.
+		 *
+		 * @return Number of bytes sent.
+		 *
+		 * @throws PortException If the endpoint is not open.
+		 * @throws TimeoutException If the peer's ring stays full for longer than write_timeout_ms.
+		 */
+		int send(const char *data, size_t length) override;
+
+		/**
+		 * @brief Encodes a frame into a staging buffer and sends it without allocating.
+		 *
+		 * @param max_length Upper bound on the number of bytes the writer produces.
+		 * @param writer Callable writing the frame and returning its actual size.
+		 *
+		 * @return Number of bytes sent.
+		 */
+		int sendInPlace(size_t max_length, const FrameWriter &writer) override;
+
+		/**
+		 * @brief Reads raw bytes sent by the peer, bypassing framing.
+		 *
+		 * Only valid with Delivery::Manual, where no receive thread competes for the bytes.
+		 *
+		 * @param buffer Pointer to the buffer where received data will be stored.
+		 * @param length Maximum number of bytes to receive.
+		 *
+		 * @return Number of bytes received, or -1 with Delivery::Thread.
+		 */
+		int receive(char *buffer, size_t length) override;
+
+		/**
+		 * @brief Gets the number of bytes sent by the peer and not yet consumed.
+		 *
+		 * @return Number of available bytes.
+		 */
+		int available() const override;
+
+		/**
+		 * @brief Gets the current configuration.
+		 *
+		 * @return A copy of the SerialConfig in use.
+		 */
+		SerialConfig get_config() const override
+		{
+			return m_config;
+		}
+
+		/**
+		 * @brief Frames everything the peer has sent so far and notifies subscribers.
+		 *
+		 * Runs on the calling thread. Only valid with Delivery::Manual.
+		 *
+		 * @return Number of frames delivered.
+		 */
+		size_t poll();
+
+		/**
+		 * @brief Gets the number of bytes discarded because of invalid length bytes.
+		 *
+		 * @return Dropped byte count since construction.
+		 */
+		size_t droppedBytes() const
+		{
+			return m_framer.droppedBytes();
+		}
+
+	private:
+		/// @brief Byte ring carrying one direction of the pair.
+		using Channel = SpscQueue<char>;
+
+		/**
+		 * @brief Constructs one endpoint of a pair.
+		 *
+		 * @param config Configuration of the endpoint.
+		 * @param delivery How received bytes are delivered.
+		 * @param rx Ring the peer sends into.
+		 * @param tx Ring this endpoint sends into.
+		 */
+		MemoryTransport(const SerialConfig &config, Delivery delivery, std::shared_ptr<Channel> rx, std::shared_ptr<Channel> tx);
+
+		/**
+		 * @brief Main loop for the receive thread.
+		 */
+		void receiveThread();
+
+		/**
+		 * @brief Moves pending bytes into the receive ring and delivers complete frames.
+		 *
+		 * @return Number of frames delivered.
+		 */
+		size_t drain();
+
+		/**
+		 * @brief Copies data into the peer's ring, waiting for space if needed.
+		 *
+		 * Must be called with mtxTransmit held.
+		 *
+		 * @param data Pointer to the data buffer to send.
+		 * @param length Number of bytes to send.
+		 *
+		 * @throws TimeoutException If the ring stays full for longer than write_timeout_ms.
+		 */
+		void pushAll(const char *data, size_t length);
+
+		/// @brief How received bytes are delivered.
+		Delivery m_delivery;
+		/// @brief Ring the peer sends into.
+		std::shared_ptr<Channel> m_rx;
+		/// @brief Ring this endpoint sends into.
+		std::shared_ptr<Channel> m_tx;
+
+		/// @brief The receive thread object (Delivery::Thread only).
+		std::thread m_thread;
+		/// @brief Set by close() to stop the receive thread.
+		std::atomic<bool> m_stop{false};
+
+		/// @brief Serializes senders so m_tx keeps a single producer.
+		std::mutex mtxTransmit;
+		/// @brief Staging buffer for sendInPlace().
+		char m_staging[Framer::MAX_FRAME_SIZE] = {0};
+
+		/// @brief Bytes received and not yet framed.
+		RingBuffer m_rx_ring;
+		/// @brief Splits m_rx_ring into frames according to SerialConfig::framing.
+		Framer m_framer;
+	};
+}
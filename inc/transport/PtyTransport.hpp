@@ -0,0 +1,68 @@
+#pragma once
+
+#include "UartTransport.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class PtyTransport
+	 * @brief UART transport attached to a pseudo-terminal pair it creates itself.
+	 *
+	 * The constructor allocates a pty with openpty() and points the serial
+	 * configuration at its slave side, so the full UartTransport path (termios,
+	 * framing, writer and receive threads) runs without a real port or an
+	 * external socat process. The master side is exposed through peerFd() for
+	 * the code playing the remote device.
+	 */
+	class PtyTransport : public UartTransport
+	{
+	public:
+		/**
+		 * @brief Creates a pty pair and a transport bound to its slave side.
+		 *
+		 * SerialConfig::port is ignored and replaced by the slave device name.
+		 *
+		 * @param config Serial configuration.
+		 *
+		 * @throws PortException If no pseudo-terminal can be allocated.
+		 */
+		PtyTransport(const SerialConfig &config = SerialConfig());
+
+		/**
+		 * @brief Destructor that closes the transport and both pty descriptors.
+		 */
+		~PtyTransport() override;
+
+		PtyTransport(const PtyTransport &) = delete;
+		PtyTransport &operator=(const PtyTransport &) = delete;
+
+		/**
+		 * @brief Gets the master side of the pty, which plays the remote device.
+		 *
+		 * Bytes written to it are received by the transport and bytes sent by the
+		 * transport can be read from it. The descriptor is raw and blocking.
+		 *
+		 * @return The master descriptor.
+		 */
+		int peerFd() const
+		{
+			return m_master_fd;
+		}
+
+		/**
+		 * @brief Gets the slave device path the transport opens.
+		 *
+		 * @return Path such as /dev/pts/3.
+		 */
+		const PortName &slaveName() const
+		{
+			return m_config.port;
+		}
+
+	private:
+		/// @brief Master side of the pty.
+		int m_master_fd{-1};
+		/// @brief Slave descriptor kept open so the pty survives while the transport is closed.
+		int m_slave_fd{-1};
+	};
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "TransportTypes.hpp"
+#include "messages/Message.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @struct SubscribeOptions
+	 * @brief How and for which messages a receive subscriber is called.
+	 *
+	 * The type filter is resolved through the dispatch table, so subscribers
+	 * for other types cost nothing per frame; index range and payload prefix
+	 * are checked per matching subscriber.
+	 */
+	struct SubscribeOptions
+	{
+		DispatchMode mode = DispatchMode::Inline;
+		std::string name = "";     ///< Label in SubscriberStats and, for Serial, the thread name.
+		size_t queue_limit = 1024; ///< Frames queued for a Pool or Serial subscriber before new ones are dropped.
+
+		std::optional<messages::MessageType> type; ///< Only messages of this type; empty receives every type.
+		uint32_t idx_min = 0;                                      ///< Lowest accepted message index.
+		uint32_t idx_max = std::numeric_limits<uint32_t>::max();   ///< Highest accepted message index.
+		std::vector<char> payload_prefix;                          ///< Bytes the payload must start with.
+	};
+
+	class ReceiveDispatcher;
+
+	/**
+	 * @struct DispatcherLink
+	 * @brief Cell shared by a dispatcher and its subscription handles.
+	 *
+	 * ~ReceiveDispatcher() clears dispatcher and then waits until no handle is
+	 * still unsubscribing through it.
+	 */
+	struct DispatcherLink
+	{
+		std::mutex mutex;
+		std::condition_variable idle;
+		/// @brief The dispatcher, nullptr once it is being destroyed.
+		ReceiveDispatcher *dispatcher = nullptr;
+		/// @brief Handles currently inside ReceiveDispatcher::unsubscribe().
+		unsigned users = 0;
+	};
+
+	/**
+	 * @class ReceiveSubscription
+	 * @brief Move-only handle that unsubscribes its receive callback when destroyed.
+	 *
+	 * Safe to destroy after the transport it came from, and on any thread,
+	 * including while the transport is destroyed on another one.
+	 */
+	class ReceiveSubscription
+	{
+	public:
+		ReceiveSubscription() = default;
+		~ReceiveSubscription() { unsubscribe(); }
+
+		ReceiveSubscription(ReceiveSubscription &&other) noexcept { *this = std::move(other); }
+		ReceiveSubscription &operator=(ReceiveSubscription &&other) noexcept;
+
+		ReceiveSubscription(const ReceiveSubscription &) = delete;
+		ReceiveSubscription &operator=(const ReceiveSubscription &) = delete;
+
+		/**
+		 * @brief Removes the subscription now.
+		 *
+		 * The callback is not started again afterwards; a call already running
+		 * on another thread may still finish.
+		 */
+		void unsubscribe();
+
+		/// @brief Whether this handle still owns a subscription.
+		bool active() const
+		{
+			if (m_id == 0 || !m_link)
+			{
+				return false;
+			}
+			std::lock_guard<std::mutex> lock(m_link->mutex);
+			return m_link->dispatcher != nullptr;
+		}
+
+	private:
+		friend class ReceiveDispatcher;
+
+		ReceiveSubscription(std::shared_ptr<DispatcherLink> link, uint64_t id)
+			: m_link(std::move(link)), m_id(id)
+		{
+		}
+
+		/// @brief Link to the dispatcher the subscription belongs to.
+		std::shared_ptr<DispatcherLink> m_link;
+		/// @brief Subscriber id, 0 when empty.
+		uint64_t m_id{0};
+	};
+
+	/**
+	 * @class ReceiveDispatcher
+	 * @brief Routes received messages to interested subscribers on the executor each one asked for.
+	 *
+	 * Subscribers are indexed by message type in an immutable route table.
+	 * subscribe() and unsubscribe() build a new table and publish it with an
+	 * atomic pointer swap, so they may be called at any time, including from a
+	 * callback, while dispatch() only reads the current table without locking.
+	 * Replaced tables are freed once no dispatch() is in progress.
+	 *
+	 * Inline subscribers are called on the delivering thread with the view as
+	 * received. Pool and Serial subscribers get a copy of the message queued to
+	 * the shared worker pool or to their own thread, so a slow handler only
+	 * backs up its own queue. Queue depth and handler time are tracked per
+	 * subscriber.
+	 */
+	class ReceiveDispatcher
+	{
+	public:
+		using Callback = std::function<void(const messages::MessageView &)>;
+
+		/**
+		 * @brief Constructs a dispatcher; no threads are started until needed.
+		 *
+		 * @param pool_size Worker threads started with the first Pool subscriber.
+		 * @param thread_policy Policy applied to pool and Serial threads.
+		 */
+		ReceiveDispatcher(size_t pool_size, const ThreadPolicy &thread_policy);
+
+		/**
+		 * @brief Stops all executor threads; queued messages are discarded.
+		 */
+		~ReceiveDispatcher();
+
+		ReceiveDispatcher(const ReceiveDispatcher &) = delete;
+		ReceiveDispatcher &operator=(const ReceiveDispatcher &) = delete;
+
+		/**
+		 * @brief Adds a subscriber.
+		 *
+		 * @param callback Function called for each matching message.
+		 * @param options Executor, filter, name and queue limit of the subscription.
+		 *
+		 * @return Handle that removes the subscriber when destroyed.
+		 */
+		[[nodiscard]] ReceiveSubscription subscribe(Callback callback, const SubscribeOptions &options);
+
+		/**
+		 * @brief Hands a message to every matching subscriber.
+		 *
+		 * Exceptions from Inline subscribers propagate to the caller; those from
+		 * Pool and Serial subscribers are reported on standard output.
+		 *
+		 * @param message View of the received message, valid for the duration of the call.
+		 */
+		void dispatch(const messages::MessageView &message);
+
+		/**
+		 * @brief Gets the delivery counters of every subscriber, in subscription order.
+		 *
+		 * @return One SubscriberStats per subscriber.
+		 */
+		std::vector<SubscriberStats> stats() const;
+
+	private:
+		friend class ReceiveSubscription;
+
+		/**
+		 * @struct Subscriber
+		 * @brief A subscription with its counters and, for Serial, its executor.
+		 */
+		struct Subscriber : std::enable_shared_from_this<Subscriber>
+		{
+			uint64_t id{0};
+			Callback callback;
+			SubscribeOptions options;
+			/// @brief Cleared on unsubscribe so queued messages are no longer delivered.
+			std::atomic<bool> active{true};
+
+			std::atomic<uint64_t> delivered{0};
+			std::atomic<uint64_t> dropped{0};
+			std::atomic<size_t> queue_depth{0};
+			std::atomic<size_t> max_queue_depth{0};
+			std::atomic<uint64_t> handler_ns_total{0};
+			std::atomic<uint64_t> handler_ns_max{0};
+
+			/// @brief Serial executor queue, guarded by mtx.
+			std::deque<messages::Message> queue;
+			std::mutex mtx;
+			std::condition_variable cv;
+			std::thread thread;
+			bool stop{false};
+
+			/**
+			 * @brief Checks the index range and payload prefix; the type is matched by the route table.
+			 */
+			bool matches(const messages::MessageView &message) const;
+		};
+
+		/// @brief One slot per possible type byte.
+		static constexpr size_t TYPE_SLOTS = 256;
+
+		/**
+		 * @struct Routes
+		 * @brief Immutable snapshot of the subscribers, indexed by message type.
+		 *
+		 * The subscribers for type t are targets[offsets[t]] up to targets[offsets[t + 1]].
+		 */
+		struct Routes
+		{
+			/// @brief Every subscriber, in subscription order; keeps them alive while the snapshot is in use.
+			std::vector<std::shared_ptr<Subscriber>> subscribers;
+			std::vector<Subscriber *> targets;
+			std::array<uint32_t, TYPE_SLOTS + 1> offsets{};
+		};
+
+		/**
+		 * @brief Builds and publishes a route table for subscribers; caller holds m_update_mtx.
+		 */
+		void publish(std::vector<std::shared_ptr<Subscriber>> subscribers);
+
+		/**
+		 * @brief Removes a subscriber and stops its Serial thread.
+		 */
+		void unsubscribe(uint64_t id);
+
+		/**
+		 * @brief Reserves a queue slot for a Pool or Serial subscriber.
+		 *
+		 * @return false (and counts a drop) if the subscriber is at its queue limit.
+		 */
+		bool reserveSlot(Subscriber &subscriber);
+
+		/**
+		 * @brief Runs a subscriber's callback and updates its counters.
+		 */
+		void invoke(Subscriber &subscriber, const messages::MessageView &message);
+
+		/**
+		 * @brief Runs invoke() for a queued message, reporting exceptions.
+		 */
+		void invokeQueued(Subscriber &subscriber, const messages::Message &message);
+
+		/**
+		 * @brief Main loop of a Serial subscriber's thread.
+		 */
+		void serialThread(std::shared_ptr<Subscriber> subscriber);
+
+		/**
+		 * @brief Main loop of a pool worker.
+		 */
+		void poolThread();
+
+		/**
+		 * @brief Starts the pool workers if they are not running.
+		 */
+		void startPool();
+
+		/// @brief Current route table, read by dispatch() without locking.
+		std::atomic<const Routes *> m_routes{nullptr};
+		/// @brief Number of dispatch() calls currently reading a route table.
+		std::atomic<uint32_t> m_readers{0};
+		/// @brief Owner of the current table, guarded by m_update_mtx.
+		std::unique_ptr<const Routes> m_current;
+		/// @brief Replaced tables waiting until no dispatch() can still read them, guarded by m_update_mtx.
+		std::vector<std::unique_ptr<const Routes>> m_retired;
+		/// @brief Serializes subscribe() and unsubscribe().
+		mutable std::mutex m_update_mtx;
+		/// @brief Id handed to the next subscriber.
+		uint64_t m_next_id{1};
+		/// @brief Cleared when the dispatcher is destroyed, so late subscription handles do nothing.
+		std::shared_ptr<DispatcherLink> m_link;
+
+		/// @brief Number of pool workers started by startPool().
+		size_t m_pool_size;
+		/// @brief Policy applied to pool and Serial threads.
+		ThreadPolicy m_thread_policy;
+
+		/// @brief Messages waiting for a pool worker, with the subscriber they are for.
+		std::deque<std::pair<std::shared_ptr<Subscriber>, messages::Message>> m_pool_queue;
+		/// @brief Guards m_pool_queue and m_pool_stop.
+		std::mutex m_pool_mtx;
+		/// @brief Signalled when a message is queued or the pool stops.
+		std::condition_variable m_pool_cv;
+		/// @brief Pool worker threads.
+		std::vector<std::thread> m_pool;
+		/// @brief Set by the destructor to stop the pool workers.
+		bool m_pool_stop{false};
+	};
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace wm::transport
+{
+	/**
+	 * @class RingBuffer
+	 * @brief Fixed-capacity circular byte buffer used for bulk stream I/O.
+	 *
+	 * RingBuffer lets a transport read everything the kernel has buffered with a
+	 * single scatter read into its free space, and lets a framer consume complete
+	 * frames straight out of the stored bytes. Data that wraps around the end of
+	 * the storage is exposed as two segments.
+	 *
+	 * @note RingBuffer is not thread-safe; callers must serialize access.
+	 */
+	class RingBuffer
+	{
+	public:
+		/**
+		 * @brief Constructs a ring buffer with the given capacity.
+		 *
+		 * @param capacity Number of bytes the buffer can hold.
+		 */
+		explicit RingBuffer(size_t capacity) : m_storage(capacity) {}
+
+		/**
+		 * @brief Gets the total capacity of the buffer.
+		 *
+		 * @return Capacity in bytes.
+		 */
+		size_t capacity() const { return m_storage.size(); }
+
+		/**
+		 * @brief Gets the whole backing storage, e.g. to register it with the kernel once.
+		 *
+		 * @return Span over all capacity() bytes.
+		 */
+		std::span<char> storage() { return m_storage; }
+
+		/**
+		 * @brief Gets the number of bytes currently stored.
+		 *
+		 * @return Stored byte count.
+		 */
+		size_t size() const { return m_size; }
+
+		/**
+		 * @brief Gets the number of bytes that can still be written.
+		 *
+		 * @return Free space in bytes.
+		 */
+		size_t space() const { return capacity() - m_size; }
+
+		/**
+		 * @brief Checks whether the buffer holds no data.
+		 *
+		 * @return true if empty, false otherwise.
+		 */
+		bool empty() const { return m_size == 0; }
+
+		/**
+		 * @brief Discards all stored data.
+		 */
+		void clear()
+		{
+			m_head = 0;
+			m_size = 0;
+		}
+
+		/**
+		 * @brief Gets the free space as up to two contiguous segments.
+		 *
+		 * The second segment is empty unless the free space wraps around the
+		 * end of the storage. Suitable for building a readv() iovec array.
+		 *
+		 * @return Array of two writable segments, in stream order.
+		 */
+		std::array<std::span<char>, 2> writable()
+		{
+			size_t tail = (m_head + m_size) % capacity();
+			size_t free = space();
+			size_t first = std::min(free, capacity() - tail);
+			return {std::span<char>(m_storage.data() + tail, first),
+					std::span<char>(m_storage.data(), free - first)};
+		}
+
+		/**
+		 * @brief Marks bytes written into the writable() segments as stored.
+		 *
+		 * @param count Number of bytes that were written.
+		 */
+		void commit(size_t count)
+		{
+			m_size += std::min(count, space());
+		}
+
+		/**
+		 * @brief Copies data into the buffer.
+		 *
+		 * @param data Pointer to the bytes to store.
+		 * @param length Number of bytes to store.
+		 *
+		 * @return Number of bytes actually stored (limited by free space).
+		 */
+		size_t write(const char *data, size_t length)
+		{
+			size_t written = 0;
+			for (auto segment : writable())
+			{
+				size_t chunk = std::min(segment.size(), length - written);
+				std::memcpy(segment.data(), data + written, chunk);
+				written += chunk;
+			}
+			commit(written);
+			return written;
+		}
+
+		/**
+		 * @brief Gets the stored data as up to two contiguous segments.
+		 *
+		 * @return Array of two readable segments, in stream order.
+		 */
+		std::array<std::span<const char>, 2> readableSegments() const
+		{
+			size_t first = std::min(m_size, capacity() - m_head);
+			return {std::span<const char>(m_storage.data() + m_head, first),
+					std::span<const char>(m_storage.data(), m_size - first)};
+		}
+
+		/**
+		 * @brief Gets the first contiguous run of stored data.
+		 *
+		 * @return Readable span starting at the oldest stored byte.
+		 */
+		std::span<const char> readable() const
+		{
+			return readableSegments()[0];
+		}
+
+		/**
+		 * @brief Gets the first contiguous run of stored data for in-place decoding.
+		 *
+		 * @return Mutable span starting at the oldest stored byte.
+		 */
+		std::span<char> readable()
+		{
+			size_t first = std::min(m_size, capacity() - m_head);
+			return std::span<char>(m_storage.data() + m_head, first);
+		}
+
+		/**
+		 * @brief Removes bytes from the front of the buffer.
+		 *
+		 * @param count Number of bytes to drop.
+		 */
+		void consume(size_t count)
+		{
+			count = std::min(count, m_size);
+			m_size -= count;
+			m_head = m_size == 0 ? 0 : (m_head + count) % capacity();
+		}
+
+		/**
+		 * @brief Moves the stored data so it is contiguous from the start of storage.
+		 *
+		 * Called when a frame straddles the wrap point; the cost is amortized
+		 * over a full pass around the buffer.
+		 */
+		void linearize()
+		{
+			std::rotate(m_storage.begin(), m_storage.begin() + m_head, m_storage.end());
+			m_head = 0;
+		}
+
+	private:
+		/// @brief Backing storage.
+		std::vector<char> m_storage;
+		/// @brief Index of the oldest stored byte.
+		size_t m_head{0};
+		/// @brief Number of stored bytes.
+		size_t m_size{0};
+	};
+}
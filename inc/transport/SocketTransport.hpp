@@ -0,0 +1,109 @@
+#pragma once
+
+#include "UartTransport.hpp"
+
+#include <sys/socket.h>
+
+namespace wm::transport
+{
+	/**
+	 * @class SocketTransport
+	 * @brief Stream socket transport over TCP or AF_UNIX.
+	 *
+	 * Connects to a serial bridge (ser2net and the like) or a local service and
+	 * runs the same framing, writer thread, receive queue and reactor support
+	 * as UartTransport on the socket descriptor, without a pty hop. TCP
+	 * sockets get TCP_NODELAY so small frames are not held back by Nagle's
+	 * algorithm, and the kernel buffer sizes can be tuned through SocketConfig.
+	 *
+	 * SerialConfig still supplies the ring sizes and timeouts; its port field
+	 * is replaced by a description of the endpoint (tcp://host:port or unix:path).
+	 */
+	class SocketTransport : public UartTransport
+	{
+	public:
+		/**
+		 * @brief Constructs a transport that connects on open().
+		 *
+		 * @param socket_config Endpoint and socket options.
+		 * @param config Buffer sizes and timeouts.
+		 */
+		SocketTransport(const SocketConfig &socket_config, const SerialConfig &config = SerialConfig());
+
+		/**
+		 * @brief Constructs a transport around an already connected stream socket.
+		 *
+		 * Useful for the accepting side of a connection or for socketpair().
+		 * The transport takes ownership of the descriptor.
+		 *
+		 * @param connected_fd Connected stream socket.
+		 * @param socket_config Socket options to apply (endpoint fields are ignored).
+		 * @param config Buffer sizes and timeouts.
+		 */
+		SocketTransport(int connected_fd, const SocketConfig &socket_config = SocketConfig(), const SerialConfig &config = SerialConfig());
+
+		/**
+		 * @brief Destructor that closes the connection if open.
+		 */
+		~SocketTransport() override;
+
+		/**
+		 * @brief Gets the socket configuration.
+		 *
+		 * @return A copy of the SocketConfig in use.
+		 */
+		SocketConfig get_socket_config() const
+		{
+			return m_socket_config;
+		}
+
+	protected:
+		/**
+		 * @brief Connects the socket (or adopts the given one) and applies the socket options.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode openDescriptor() override;
+
+		/**
+		 * @brief Writes with sendmsg(MSG_NOSIGNAL) so a closed peer reports EPIPE instead of raising SIGPIPE.
+		 *
+		 * @param iov Segments to write.
+		 * @param iov_count Number of entries in iov.
+		 *
+		 * @return Number of bytes written, or -1 with errno set.
+		 */
+		ssize_t writeSegments(const struct iovec *iov, int iov_count) override;
+
+	private:
+		/**
+		 * @brief Creates a socket connected to the configured endpoint and stores it in m_fd.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode connectSocket();
+
+		/**
+		 * @brief Connects a non-blocking socket, waiting up to connect_timeout_ms.
+		 *
+		 * @param fd The socket.
+		 * @param address Peer address.
+		 * @param length Size of address.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode connectWithTimeout(int fd, const struct sockaddr *address, socklen_t length);
+
+		/**
+		 * @brief Applies TCP_NODELAY, buffer sizes and O_NONBLOCK to m_fd.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode configureSocket();
+
+		/// @brief Endpoint and socket options.
+		SocketConfig m_socket_config;
+		/// @brief Descriptor handed to the constructor, adopted by the first open().
+		int m_adopted_fd{-1};
+	};
+}
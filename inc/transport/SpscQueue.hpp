@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace wm::transport
+{
+	/// @brief Cache line size used to keep producer and consumer state apart.
+	constexpr size_t CACHE_LINE_SIZE = 64;
+
+	/**
+	 * @class SpscQueue
+	 * @brief Bounded lock-free single-producer/single-consumer ring.
+	 *
+	 * One thread pushes and one thread pops without taking a lock. The producer
+	 * and consumer indices live on separate cache lines, and each side keeps a
+	 * cached copy of the other side's index so the shared lines are only touched
+	 * when the cached view runs out. A full queue makes tryPush() fail instead of
+	 * blocking, so the producer can count the overflow and carry on.
+	 *
+	 * The consumer may block in waitForData(); the producer only pays for a
+	 * wake-up (mutex + notify) when the consumer is actually asleep.
+	 *
+	 * @tparam T Element type; must be default constructible and copy assignable.
+	 */
+	template <typename T>
+	class SpscQueue
+	{
+	public:
+		/**
+		 * @brief Constructs a queue holding at least capacity elements.
+		 *
+		 * @param capacity Requested capacity, rounded up to a power of two.
+		 */
+		explicit SpscQueue(size_t capacity)
+		{
+			size_t rounded = 2;
+			while (rounded < capacity)
+			{
+				rounded <<= 1;
+			}
+			m_slots.resize(rounded);
+			m_mask = rounded - 1;
+		}
+
+		SpscQueue(const SpscQueue &) = delete;
+		SpscQueue &operator=(const SpscQueue &) = delete;
+
+		/**
+		 * @brief Gets the number of slots in the queue.
+		 *
+		 * @return Capacity in elements.
+		 */
+		size_t capacity() const { return m_slots.size(); }
+
+		/**
+		 * @brief Gets an approximate number of queued elements.
+		 *
+		 * @return Queued element count (exact only when called from the producer or consumer).
+		 */
+		size_t size() const
+		{
+			return m_producer.tail.load(std::memory_order_acquire) - m_consumer.head.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Checks whether the queue is empty.
+		 *
+		 * @return true if no element is queued.
+		 */
+		bool empty() const { return size() == 0; }
+
+		/**
+		 * @brief Appends an element (producer side).
+		 *
+		 * @param value The element to copy into the queue.
+		 *
+		 * @return true if queued, false if the queue was full.
+		 */
+		bool tryPush(const T &value)
+		{
+			size_t tail = m_producer.tail.load(std::memory_order_relaxed);
+			if (tail - m_producer.cached_head >= capacity())
+			{
+				m_producer.cached_head = m_consumer.head.load(std::memory_order_acquire);
+				if (tail - m_producer.cached_head >= capacity())
+				{
+					return false;
+				}
+			}
+
+			m_slots[tail & m_mask] = value;
+			m_producer.tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Appends as many elements of an array as fit (producer side).
+		 *
+		 * Copies at most two contiguous runs and publishes them with a single
+		 * store, which makes it suitable for moving bulk bytes.
+		 *
+		 * @param values Elements to copy into the queue.
+		 * @param count Number of elements in values.
+		 *
+		 * @return Number of elements queued (may be less than count).
+		 */
+		size_t tryPushBatch(const T *values, size_t count)
+		{
+			size_t tail = m_producer.tail.load(std::memory_order_relaxed);
+			if (capacity() - (tail - m_producer.cached_head) < count)
+			{
+				m_producer.cached_head = m_consumer.head.load(std::memory_order_acquire);
+			}
+
+			count = std::min(count, capacity() - (tail - m_producer.cached_head));
+			size_t first = std::min(count, capacity() - (tail & m_mask));
+			std::copy_n(values, first, m_slots.data() + (tail & m_mask));
+			std::copy_n(values + first, count - first, m_slots.data());
+
+			if (count > 0)
+			{
+				m_producer.tail.store(tail + count, std::memory_order_release);
+			}
+			return count;
+		}
+
+		/**
+		 * @brief Removes the oldest element (consumer side).
+		 *
+		 * @param value Receives the popped element.
+		 *
+		 * @return true if an element was popped, false if the queue was empty.
+		 */
+		bool tryPop(T &value)
+		{
+			return popBatch([&value](const T &item)
+							{ value = item; }, 1) == 1;
+		}
+
+		/**
+		 * @brief Removes up to max_count elements into an array (consumer side).
+		 *
+		 * @param out Destination array with room for max_count elements.
+		 * @param max_count Maximum number of elements to pop.
+		 *
+		 * @return Number of elements popped.
+		 */
+		size_t popBatch(T *out, size_t max_count)
+		{
+			size_t head = m_consumer.head.load(std::memory_order_relaxed);
+			if (m_consumer.cached_tail - head < max_count)
+			{
+				m_consumer.cached_tail = m_producer.tail.load(std::memory_order_acquire);
+			}
+
+			size_t count = std::min(max_count, m_consumer.cached_tail - head);
+			size_t first = std::min(count, capacity() - (head & m_mask));
+			std::copy_n(m_slots.data() + (head & m_mask), first, out);
+			std::copy_n(m_slots.data(), count - first, out + first);
+
+			if (count > 0)
+			{
+				m_consumer.head.store(head + count, std::memory_order_release);
+			}
+			return count;
+		}
+
+		/**
+		 * @brief Hands up to max_count elements to a callback in place, then removes them (consumer side).
+		 *
+		 * The slots are only released after the callback returns, so elements are
+		 * not copied out of the ring.
+		 *
+		 * @tparam F Callable with signature void(const T &).
+		 * @param consumer Callback invoked for each element, oldest first.
+		 * @param max_count Maximum number of elements to consume.
+		 *
+		 * @return Number of elements consumed.
+		 */
+		template <typename F>
+		size_t popBatch(F &&consumer, size_t max_count)
+		{
+			size_t head = m_consumer.head.load(std::memory_order_relaxed);
+			if (m_consumer.cached_tail == head)
+			{
+				m_consumer.cached_tail = m_producer.tail.load(std::memory_order_acquire);
+			}
+
+			size_t available = m_consumer.cached_tail - head;
+			size_t count = available < max_count ? available : max_count;
+			for (size_t i = 0; i < count; ++i)
+			{
+				consumer(m_slots[(head + i) & m_mask]);
+			}
+
+			if (count > 0)
+			{
+				m_consumer.head.store(head + count, std::memory_order_release);
+			}
+			return count;
+		}
+
+		/**
+		 * @brief Blocks the consumer until data is queued, wake() is called or the timeout expires.
+		 *
+		 * @param timeout Maximum time to wait.
+		 *
+		 * @return true if the queue holds data.
+		 */
+		bool waitForData(std::chrono::milliseconds timeout)
+		{
+			if (!empty())
+			{
+				return true;
+			}
+
+			std::unique_lock<std::mutex> lock(m_wait_mutex);
+			m_consumer_waiting.store(true, std::memory_order_seq_cst);
+			m_wait_cv.wait_for(lock, timeout, [this]
+							   { return !empty() || m_wake_pending; });
+			m_consumer_waiting.store(false, std::memory_order_relaxed);
+			m_wake_pending = false;
+			return !empty();
+		}
+
+		/**
+		 * @brief Wakes the consumer if it is blocked in waitForData() (producer side).
+		 *
+		 * Call after one or more tryPush() calls; costs a single load when the
+		 * consumer is not waiting.
+		 */
+		void notifyConsumer()
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_consumer_waiting.load(std::memory_order_seq_cst))
+			{
+				std::lock_guard<std::mutex> lock(m_wait_mutex);
+				m_wait_cv.notify_one();
+			}
+		}
+
+		/**
+		 * @brief Forces a blocked waitForData() to return, e.g. on shutdown.
+		 */
+		void wake()
+		{
+			std::lock_guard<std::mutex> lock(m_wait_mutex);
+			m_wake_pending = true;
+			m_wait_cv.notify_all();
+		}
+
+	private:
+		/// @brief Producer-owned state, on its own cache line.
+		struct alignas(CACHE_LINE_SIZE) ProducerState
+		{
+			std::atomic<size_t> tail{0};
+			size_t cached_head{0};
+		};
+
+		/// @brief Consumer-owned state, on its own cache line.
+		struct alignas(CACHE_LINE_SIZE) ConsumerState
+		{
+			std::atomic<size_t> head{0};
+			size_t cached_tail{0};
+		};
+
+		ProducerState m_producer;
+		ConsumerState m_consumer;
+
+		/// @brief Element storage (power-of-two sized).
+		std::vector<T> m_slots;
+		/// @brief Index mask (capacity - 1).
+		size_t m_mask{0};
+
+		/// @brief Set while the consumer sleeps in waitForData().
+		alignas(CACHE_LINE_SIZE) std::atomic<bool> m_consumer_waiting{false};
+		/// @brief Set by wake() to end a wait without data.
+		bool m_wake_pending{false};
+		std::mutex m_wait_mutex;
+		std::condition_variable m_wait_cv;
+	};
+}
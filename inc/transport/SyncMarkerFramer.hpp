@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "LengthPrefixFramer.hpp"
+#include "RingBuffer.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class SyncMarkerFramer
+	 * @brief Splits a received byte stream into marker-delimited frames.
+	 *
+	 * Every frame on the wire is preceded by a two byte header: SYNC_MARKER and
+	 * the one's complement of the length byte that follows. The frame itself is
+	 * the usual length-prefixed frame (see LengthPrefixFramer), so callbacks see
+	 * exactly what they would without markers.
+	 *
+	 * When the header does not check out the framer skips to the next marker
+	 * with memchr() instead of retrying every byte as a length, so a corrupted or
+	 * dropped byte costs at most the frame it hit.
+	 */
+	class SyncMarkerFramer
+	{
+	public:
+		/// @brief Start-of-frame marker.
+		static constexpr uint8_t SYNC_MARKER = 0xA5;
+		/// @brief Bytes written ahead of each length-prefixed frame.
+		static constexpr size_t HEADER_SIZE = 2;
+		/// @brief Largest frame on the wire, including the header.
+		static constexpr size_t MAX_FRAME_SIZE = HEADER_SIZE + LengthPrefixFramer::MAX_FRAME_SIZE;
+
+		/**
+		 * @brief Writes the header for a frame starting with length_byte.
+		 *
+		 * @param out Destination, at least HEADER_SIZE bytes long.
+		 * @param length_byte First byte of the length-prefixed frame.
+		 */
+		static void writeHeader(char *out, char length_byte)
+		{
+			out[0] = static_cast<char>(SYNC_MARKER);
+			out[1] = static_cast<char>(~static_cast<uint8_t>(length_byte));
+		}
+
+		/**
+		 * @brief Extracts all complete frames currently stored in the ring.
+		 *
+		 * Bytes ahead of a valid header are dropped. Frames that straddle the wrap
+		 * point of the ring are made contiguous before being reported.
+		 *
+		 * @tparam F Callable with signature void(const char *frame, size_t length).
+		 * @param ring The ring buffer holding received bytes; consumed frames are removed.
+		 * @param on_frame Callback invoked for each complete frame, without its header.
+		 *
+		 * @return Number of frames extracted.
+		 */
+		template <typename F>
+		size_t extract(RingBuffer &ring, F &&on_frame)
+		{
+			size_t frames = 0;
+
+			while (!ring.empty())
+			{
+				auto data = ring.readable();
+				bool wrapped = data.size() != ring.size();
+				size_t consumed = 0;
+
+				while (consumed < data.size())
+				{
+					const char *frame = data.data() + consumed;
+					size_t remaining = data.size() - consumed;
+
+					if (static_cast<uint8_t>(frame[0]) != SYNC_MARKER)
+					{
+						const void *marker = std::memchr(frame, SYNC_MARKER, remaining);
+						size_t skipped = marker != nullptr ? static_cast<const char *>(marker) - frame : remaining;
+						loseSync(skipped);
+						consumed += skipped;
+						continue;
+					}
+
+					if (remaining < HEADER_SIZE + 1)
+					{
+						break;
+					}
+
+					uint8_t length = static_cast<uint8_t>(frame[HEADER_SIZE]);
+					if (static_cast<uint8_t>(frame[1]) != static_cast<uint8_t>(~length) ||
+						length < LengthPrefixFramer::MIN_LENGTH || length > LengthPrefixFramer::MAX_FRAME_SIZE - 1)
+					{
+						// A marker byte inside payload data; look for the next one.
+						loseSync(1);
+						++consumed;
+						continue;
+					}
+
+					size_t frame_size = HEADER_SIZE + 1 + static_cast<size_t>(length);
+					if (remaining < frame_size)
+					{
+						break;
+					}
+
+					on_frame(frame + HEADER_SIZE, frame_size - HEADER_SIZE);
+					consumed += frame_size;
+					m_in_sync = true;
+					++frames;
+				}
+
+				ring.consume(consumed);
+
+				if (!wrapped)
+				{
+					break;
+				}
+
+				ring.linearize();
+			}
+
+			return frames;
+		}
+
+		/**
+		 * @brief Gets the number of bytes discarded while searching for a marker.
+		 *
+		 * @return Dropped byte count since construction.
+		 */
+		size_t droppedBytes() const { return m_dropped_bytes; }
+
+		/**
+		 * @brief Gets how many times the framer lost synchronization.
+		 *
+		 * @return Number of times valid frames were followed by unframed bytes.
+		 */
+		size_t syncLosses() const { return m_sync_losses; }
+
+	private:
+		/// @brief Accounts for skipped bytes and counts the first skip after a valid frame.
+		void loseSync(size_t skipped)
+		{
+			m_dropped_bytes += skipped;
+			if (m_in_sync && skipped > 0)
+			{
+				++m_sync_losses;
+				m_in_sync = false;
+			}
+		}
+
+		/// @brief Bytes skipped while searching for a valid header.
+		size_t m_dropped_bytes{0};
+		/// @brief Times synchronization was lost.
+		size_t m_sync_losses{0};
+		/// @brief Whether the last bytes examined formed a valid frame.
+		bool m_in_sync{false};
+	};
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// Deliberately free of <termios.h>: the termios2 definitions in <asm/termbits.h>
+// clash with it, so they are only included by Termios2.cpp.
+
+namespace wm::transport
+{
+    /**
+     * @brief Applies an arbitrary line rate using termios2 and BOTHER.
+     *
+     * Only the speed fields are changed; every other termios setting is kept.
+     *
+     * @param fd Open serial port descriptor.
+     * @param rate Requested rate in bits per second.
+     *
+     * @return true if the driver accepted the request.
+     */
+    bool set_custom_baudrate(int fd, uint32_t rate);
+
+    /**
+     * @brief Reads back the output rate actually in effect on a serial port.
+     *
+     * Drivers round requests to what their clock divider can produce, so this
+     * may differ from the requested rate.
+     *
+     * @param fd Open serial port descriptor.
+     *
+     * @return Rate in bits per second, or 0 if it cannot be queried.
+     */
+    uint32_t get_actual_baudrate(int fd);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <thread>
+
+#include "TransportTypes.hpp"
+
+namespace wm::transport
+{
+    /**
+     * @brief Applies a ThreadPolicy to the calling thread.
+     *
+     * Sets the thread name (policy.name, or default_name when empty), the CPU
+     * affinity and the scheduling policy. Every step is attempted; failures,
+     * typically a missing CAP_SYS_NICE for real-time policies, are reported on
+     * standard output.
+     *
+     * @param policy The policy to apply.
+     * @param default_name Name used when policy.name is empty.
+     *
+     * @return Success, InvalidParameter for an invalid policy, or OperationFailed if a step was refused.
+     */
+    ErrorCode apply_thread_policy(const ThreadPolicy &policy, const char *default_name);
+
+    /**
+     * @brief Locks all current and future pages of the process into memory.
+     *
+     * @return Success, or OperationFailed (reported on standard output) if refused.
+     */
+    ErrorCode lock_process_memory();
+
+    /**
+     * @brief Waits for a worker thread that has been told to stop.
+     *
+     * Joins the thread, unless it is the calling thread (a user callback closing
+     * the transport that runs it); that thread is detached instead and exits on
+     * its own once the callback returns. Either way the std::thread object is
+     * left non-joinable and can be started again.
+     *
+     * @param thread The thread to release; ignored if not joinable.
+     */
+    void release_thread(std::thread &thread);
+}
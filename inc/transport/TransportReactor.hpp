@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "TransportTypes.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class IPollable
+	 * @brief Interface for transports that can be serviced by a TransportReactor.
+	 *
+	 * The reactor watches pollFd() and calls onReadable() whenever it has data.
+	 * The implementation reads what is pending, frames it and dispatches the
+	 * messages on the calling reactor thread.
+	 */
+	class IPollable
+	{
+	public:
+		/**
+		 * @brief Virtual destructor.
+		 */
+		virtual ~IPollable() = default;
+
+		/**
+		 * @brief Gets the file descriptor to watch for readability.
+		 *
+		 * @return The descriptor, or -1 if not open.
+		 */
+		virtual int pollFd() const = 0;
+
+		/**
+		 * @brief Called by the reactor when pollFd() is readable.
+		 *
+		 * @return false to make the reactor stop watching the descriptor.
+		 */
+		virtual bool onReadable() = 0;
+
+		/**
+		 * @brief Called by the reactor when pollFd() reports an error or hangup.
+		 *
+		 * The reactor has already stopped watching the descriptor.
+		 */
+		virtual void onPollError() = 0;
+	};
+
+	/**
+	 * @class TransportReactor
+	 * @brief Services many transports from a single epoll set.
+	 *
+	 * Instead of every transport running its own receive and dispatch threads,
+	 * transports that opt in register their descriptor with a shared reactor.
+	 * One thread (or a small fixed pool) waits on the epoll set and runs framing
+	 * and dispatch for whichever transports are readable, so CPU and thread cost
+	 * stay flat as the number of ports grows.
+	 *
+	 * With more than one thread, descriptors are armed with EPOLLONESHOT so a
+	 * transport is never serviced by two threads at once.
+	 *
+	 * Handlers run without the reactor lock held, so a receive callback may
+	 * close any transport on the same reactor, including its own.
+	 */
+	class TransportReactor
+	{
+	public:
+		/**
+		 * @brief Constructs a reactor.
+		 *
+		 * @param thread_count Number of threads servicing the epoll set (at least one).
+		 *
+		 * @throws TransportException If the epoll set cannot be created.
+		 */
+		explicit TransportReactor(size_t thread_count = 1);
+
+		/**
+		 * @brief Destructor that stops the reactor threads.
+		 */
+		~TransportReactor();
+
+		TransportReactor(const TransportReactor &) = delete;
+		TransportReactor &operator=(const TransportReactor &) = delete;
+
+		/**
+		 * @brief Starts the reactor threads.
+		 */
+		void start();
+
+		/**
+		 * @brief Stops and joins the reactor threads.
+		 */
+		void stop();
+
+		/**
+		 * @brief Starts watching a transport.
+		 *
+		 * @param source The transport to service; its descriptor must be open.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode add(IPollable *source);
+
+		/**
+		 * @brief Stops watching a transport.
+		 *
+		 * Blocks until no other reactor thread is running a handler for the
+		 * source. May be called from that source's own handler.
+		 *
+		 * @param source The transport to remove.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode remove(IPollable *source);
+
+		/**
+		 * @brief Gets the number of registered transports.
+		 *
+		 * @return Registered transport count.
+		 */
+		size_t size() const;
+
+		/**
+		 * @brief Checks whether the reactor threads are running.
+		 *
+		 * @return true if started.
+		 */
+		bool is_running() const { return m_running.load(std::memory_order_acquire); }
+
+	private:
+		/**
+		 * @brief Main loop of a reactor thread.
+		 */
+		void run();
+
+		/// @brief Maximum events handled per epoll_wait() call.
+		static constexpr int MAX_EVENTS = 64;
+
+		/// @brief Number of threads to start.
+		size_t m_thread_count;
+		/// @brief Whether descriptors are re-armed after each event (pool mode).
+		bool m_oneshot;
+		/// @brief The epoll set.
+		int m_epoll_fd{-1};
+		/// @brief eventfd used to stop the reactor threads.
+		int m_wake_fd{-1};
+		/// @brief Reactor threads.
+		std::vector<std::thread> m_threads;
+		/// @brief Whether the reactor threads are running.
+		std::atomic<bool> m_running{false};
+		/**
+		 * @brief Runs the handler for one event on a registered source.
+		 *
+		 * @param source The source the event belongs to.
+		 * @param events The epoll event mask.
+		 *
+		 * @return Whether the source should stay armed.
+		 */
+		bool dispatch(IPollable *source, uint32_t events);
+
+		/// @brief Registered transports with the number of handlers running for each.
+		std::unordered_map<IPollable *, size_t> m_sources;
+		/// @brief Guards m_sources; never held while a handler runs.
+		mutable std::mutex m_sources_mutex;
+		/// @brief Signalled whenever a handler finishes, for remove() to wait on.
+		std::condition_variable m_handler_done;
+	};
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -12,8 +14,15 @@
 namespace wm::transport {
     using ByteBuffer = std::vector<char>;
     using PortName = std::string;
+    /// @brief Nanoseconds on CLOCK_MONOTONIC (see monotonic_now()); 0 means not recorded.
     using Timestamp = uint64_t;
+    /// @brief Completion callback for asynchronous sends: bytes written, or a negative value on error.
+    using SendCallback = std::function<void(int)>;
+    /// @brief Writes a frame into the given buffer and returns the number of bytes written.
+    using FrameWriter = std::function<size_t(std::span<char>)>;
 
+    /// @brief Line rate in bits per second. Rates without an enumerator can be
+    /// requested with static_cast<BaudRate>(rate); they are applied through termios2.
     enum class BaudRate : uint32_t {
         Baud300 = 300,
         Baud600 = 600,
@@ -30,6 +39,11 @@ namespace wm::transport {
         Baud230400 = 230400,
         Baud460800 = 460800,
         Baud921600 = 921600,
+        Baud1000000 = 1000000,
+        Baud1500000 = 1500000,
+        Baud2000000 = 2000000,
+        Baud3000000 = 3000000,
+        Baud4000000 = 4000000,
     };
 
     enum class DataBits {
@@ -88,12 +102,68 @@ namespace wm::transport {
     };
 
 
+    /// @brief Trade-off between per-frame latency and CPU/USB efficiency on serial ports.
+    /// Only driver settings change: both I/O backends read the port non-blocking,
+    /// so termios VMIN/VTIME would be ignored and are left at 0.
+    enum class LatencyProfile {
+        Throughput, ///< Let the driver and USB adapter batch bytes (default 16 ms latency timer).
+        Balanced,   ///< Leave driver settings alone; wake on the first received byte.
+        LowLatency, ///< ASYNC_LOW_LATENCY and a 1 ms USB latency timer where available.
+    };
+
+    /// @brief Kernel interface used to drive a serial port.
+    enum class IoBackend {
+        Epoll,   ///< Reader and writer threads around epoll/readv/writev.
+        IoUring, ///< One thread submitting reads and writes through io_uring.
+    };
+
+    /// @brief How frames are delimited on a byte stream.
+    enum class FramingMode {
+        LengthPrefix, ///< Bare length byte; a corrupted length misparses the stream until it realigns.
+        SyncMarker,   ///< Start-of-frame marker and length check ahead of the length byte; resyncs within one frame.
+        Cobs,         ///< COBS-encoded frames delimited by 0x00; resyncs at the next delimiter, at most 2 bytes of overhead.
+        CobsR,        ///< Like Cobs with COBS/R encoding, which usually saves the code byte.
+    };
+
     enum class ConnectionState {
         Closed = 0,
         Open = 1,
         Error = 2,
     };
 
+    enum class SchedPolicy {
+        Default,    ///< SCHED_OTHER, priority ignored.
+        Fifo,       ///< SCHED_FIFO real-time policy.
+        RoundRobin, ///< SCHED_RR real-time policy.
+    };
+
+    /// @brief Placement, scheduling and name of a transport worker thread.
+    struct ThreadPolicy {
+        std::vector<int> cpus; ///< CPUs the thread may run on; empty allows all.
+        SchedPolicy policy = SchedPolicy::Default;
+        int priority = 0;      ///< Real-time priority (1-99) for Fifo and RoundRobin.
+        std::string name = ""; ///< Name shown by top -H (at most 15 characters); empty keeps the default.
+    };
+
+    /// @brief Where a receive subscriber's callback runs.
+    enum class DispatchMode {
+        Inline, ///< On the thread delivering the frame; must be quick.
+        Pool,   ///< On the transport's shared worker pool; no ordering between frames.
+        Serial, ///< On a thread of its own, in receive order.
+    };
+
+    /// @brief Delivery counters of one receive subscriber.
+    struct SubscriberStats {
+        std::string name;
+        DispatchMode mode = DispatchMode::Inline;
+        uint64_t delivered = 0;       ///< Callbacks completed.
+        uint64_t dropped = 0;         ///< Frames discarded because the queue was at queue_limit.
+        size_t queue_depth = 0;       ///< Frames waiting right now.
+        size_t max_queue_depth = 0;   ///< Highest queue_depth seen.
+        uint64_t handler_ns_total = 0; ///< Time spent inside the callback.
+        uint64_t handler_ns_max = 0;   ///< Longest single callback.
+    };
+
     struct SerialConfig {
 		PortName port = "";
         BaudRate baudrate = BaudRate::Baud115200;
@@ -104,8 +174,67 @@ namespace wm::transport {
         uint32_t write_timeout_ms = 1000;
         size_t rx_buffer_size = 4096;
         size_t tx_buffer_size = 4096;
+        size_t rx_queue_depth = 256;
+        IoBackend io_backend = IoBackend::Epoll;
+        LatencyProfile latency_profile = LatencyProfile::Balanced;
+        FramingMode framing = FramingMode::LengthPrefix; ///< Must match the peer.
+        ThreadPolicy rx_thread;
+        ThreadPolicy tx_thread;
+        ThreadPolicy dispatch_thread; ///< Also applied to DispatchMode::Pool and Serial subscriber threads.
+        size_t dispatch_pool_size = 2; ///< Worker threads for DispatchMode::Pool, started on first use.
+        bool lock_memory = false; ///< mlockall() on open so page faults cannot stall the workers.
+    };
+
+    /// @brief Address family of a stream socket transport.
+    enum class SocketFamily {
+        Tcp,  ///< TCP over IPv4 or IPv6.
+        Unix, ///< AF_UNIX stream socket.
+    };
+
+    struct SocketConfig {
+        SocketFamily family = SocketFamily::Tcp;
+        std::string host = "127.0.0.1";
+        uint16_t port = 0;
+        std::string path = "";
+        bool no_delay = true;
+        int rcvbuf_size = 0; ///< SO_RCVBUF in bytes, 0 keeps the kernel default.
+        int sndbuf_size = 0; ///< SO_SNDBUF in bytes, 0 keeps the kernel default.
+        uint32_t connect_timeout_ms = 1000;
+    };
+
+    struct DatagramConfig {
+        std::string local_host = "0.0.0.0";
+        uint16_t local_port = 0; ///< 0 binds an ephemeral port.
+        std::string remote_host = "127.0.0.1";
+        uint16_t remote_port = 0; ///< 0 leaves the socket unconnected (receive only).
+        int rcvbuf_size = 0; ///< SO_RCVBUF in bytes, 0 keeps the kernel default.
+        int sndbuf_size = 0; ///< SO_SNDBUF in bytes, 0 keeps the kernel default.
+        size_t batch_size = 32; ///< Datagrams moved per recvmmsg()/sendmmsg() call.
+        bool timestamps = true; ///< Request SO_TIMESTAMPNS receive timestamps (MessageView::kernel_rx_timestamp).
+    };
+
+    enum class FrameDirection {
+        Rx,
+        Tx,
     };
 
+    /// @brief Where one frame spent its time inside the transport.
+    ///
+    /// Stages that do not apply to the direction, or were not observed, are 0.
+    struct FrameTiming {
+        FrameDirection direction = FrameDirection::Rx;
+        size_t length = 0;        ///< Frame bytes, excluding any framing header.
+        Timestamp received = 0;   ///< Rx: read() that returned the first byte of the frame.
+        Timestamp dispatched = 0; ///< Rx: handed to the subscribers.
+        Timestamp handled = 0;    ///< Rx: inline subscribers returned and the others queued.
+        Timestamp queued = 0;     ///< Tx: accepted by send().
+        Timestamp written = 0;    ///< Tx: last byte accepted by write().
+        Timestamp drained = 0;    ///< Tx: last byte left the driver's output queue (TIOCOUTQ).
+    };
+
+    /// @brief Receives a FrameTiming for every frame once all of its stages are known.
+    using TimingCallback = std::function<void(const FrameTiming&)>;
+
     struct PortInfo {
         PortName port;
         std::string description;
@@ -148,6 +277,17 @@ namespace wm::transport {
         }
     };
 
+    class ChecksumException : public TransportException {
+    public:
+        ChecksumException(const std::string& msg = "Frame checksum mismatch")
+            : TransportException(msg, ErrorCode::ChecksumError) {
+        }
+    };
+
+    /// @brief Reads CLOCK_MONOTONIC, the clock used for every Timestamp.
+    Timestamp monotonic_now();
+
+    /// @brief Maps a rate onto its Bxxx constant, or B0 if there is none and termios2 is needed.
     speed_t baudrate_to_speed_t(BaudRate baudrate);
     unsigned int data_bits_to_csize(DataBits data_bits);
     unsigned int stop_bits_to_cstopb(StopBits stop_bits);
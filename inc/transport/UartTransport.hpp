@@ -2,17 +2,25 @@
 
 #include "ITransport.hpp"
 #include <thread>
-#include <queue>
 #include "messages/Message.hpp"
+#include "RingBuffer.hpp"
+#include "Framer.hpp"
+#include "SpscQueue.hpp"
+#include "TransportReactor.hpp"
 
 
 #include <termios.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
 
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
 
-#define RX_BUFF_SIZE 1024
 #define TX_BUFF_SIZE 1024
 
 namespace wm::transport
@@ -25,8 +33,21 @@ namespace wm::transport
 	 * for UART/serial communication. It handles opening/closing serial ports,
 	 * sending and receiving data, and managing a receive thread for asynchronous
 	 * message processing.
+	 * 
+	 * Outgoing data is copied into a bounded transmit ring and written by a
+	 * dedicated writer thread, which coalesces everything queued at that moment
+	 * into a single writev() call.
+	 * 
+	 * Received frames are pushed into a lock-free single-producer/single-consumer
+	 * queue and handed to subscribers from a separate dispatch thread, so a slow
+	 * subscriber never stalls reading the port. Frames arriving while the queue
+	 * is full are dropped and counted.
+	 * 
+	 * Alternatively the transport can be attached to a TransportReactor with
+	 * useReactor(); it then starts no receive or dispatch thread of its own and
+	 * frames are read and delivered from the reactor's threads.
 	 */
-	class UartTransport : public ITransport
+	class UartTransport : public ITransport, public IPollable
 	{
 	public:
 		/**
@@ -80,14 +101,96 @@ namespace wm::transport
 		};
 
 		/**
-		 * @brief Sends raw data over the serial port.
+		 * @brief Gets the line rate the driver reported after the port was configured.
+		 * 
+		 * Drivers round the requested rate to what their clock can produce, so
+		 * this can differ from SerialConfig::baudrate.
+		 * 
+		 * @return Rate in bits per second, or 0 if never opened or not a serial port.
+		 */
+		uint32_t actualBaudRate() const
+		{
+			return m_actual_baudrate;
+		}
+
+		/**
+		 * @brief Queues raw data for transmission over the serial port.
+		 * 
+		 * Returns as soon as the data is copied into the transmit ring; blocks only
+		 * while the ring is full.
 		 * 
 		 * @param data Pointer to the data buffer to send.
 		 * @param length Number of bytes to send.
 		 * 
-		 * @return Number of bytes successfully sent.
+		 * @return Number of bytes queued.
+		 * 
+		 * @throws PortException If the port is not open or the data exceeds the ring capacity.
+		 * @throws TimeoutException If the ring stays full for longer than write_timeout_ms.
 		 */
 		int send(const char *data, size_t length) override;
+
+		/**
+		 * @brief Queues raw data only if the transmit ring has room right now.
+		 * 
+		 * Never blocks, so producers can react to backpressure (skip, coalesce or
+		 * slow down) instead of stalling in send().
+		 * 
+		 * @param data Pointer to the data buffer to send.
+		 * @param length Number of bytes to send.
+		 * 
+		 * @return Success if queued, BufferOverflow if the ring is too full,
+		 *         PortNotOpen or InvalidParameter otherwise.
+		 */
+		ErrorCode trySend(const char *data, size_t length);
+
+		/**
+		 * @brief Gets the number of bytes accepted but not yet on the wire.
+		 * 
+		 * Counts the transmit ring plus the driver's output queue (TIOCOUTQ).
+		 * 
+		 * @return Pending transmit bytes.
+		 */
+		size_t pendingTransmitBytes() const;
+
+		/**
+		 * @brief Gets the number of received bytes discarded by the framer.
+		 * 
+		 * @return Dropped byte count since construction.
+		 */
+		size_t droppedBytes() const { return m_framer.droppedBytes(); }
+
+		/**
+		 * @brief Gets how many times the receive stream lost frame synchronization.
+		 * 
+		 * Only counted with FramingMode::SyncMarker.
+		 * 
+		 * @return Sync losses since construction.
+		 */
+		size_t syncLosses() const { return m_framer.syncLosses(); }
+
+		/**
+		 * @brief Encodes a frame straight into the transmit ring.
+		 * 
+		 * The writer runs with the ring locked and receives the free space at the
+		 * tail of the ring, or the staging buffer when that space wraps around.
+		 * 
+		 * @param max_length Upper bound on the number of bytes the writer produces.
+		 * @param writer Callable writing the frame and returning its actual size.
+		 * 
+		 * @return Number of bytes queued.
+		 */
+		int sendInPlace(size_t max_length, const FrameWriter &writer) override;
+
+		using ITransport::sendAsync;
+
+		/**
+		 * @brief Queues raw data and invokes a callback once the writer has written it.
+		 * 
+		 * @param data Pointer to the data buffer to send.
+		 * @param length Number of bytes to send.
+		 * @param on_complete Callback invoked from the writer thread with the bytes written or -1 on error.
+		 */
+		void sendAsync(const char *data, size_t length, SendCallback on_complete) override;
 		/**
 		 * @brief Receives raw data from the serial port.
 		 * 
@@ -98,7 +201,148 @@ namespace wm::transport
 		 */
 		int receive(char *buffer, size_t length) override;
 
-	private:
+		/**
+		 * @brief Services this transport from a shared reactor instead of private threads.
+		 * 
+		 * Must be called while the port is closed; pass nullptr to go back to
+		 * private receive and dispatch threads.
+		 * 
+		 * @param reactor The reactor to register with on open().
+		 * 
+		 * @throws PortException If the port is open.
+		 */
+		void useReactor(TransportReactor *reactor);
+
+		/**
+		 * @brief Gets the file descriptor watched by a reactor.
+		 * 
+		 * @return The port descriptor, or -1 if not open.
+		 */
+		int pollFd() const override
+		{
+			return m_fd;
+		}
+
+		/**
+		 * @brief Reads pending bytes and delivers complete frames (reactor mode).
+		 * 
+		 * @return false once the port has failed or the other end has closed.
+		 */
+		bool onReadable() override;
+
+		/**
+		 * @brief Marks the transport as failed after a port error (reactor mode).
+		 */
+		void onPollError() override;
+
+		/**
+		 * @brief Gets the number of received frames dropped because the receive queue was full.
+		 * 
+		 * @return Dropped frame count since construction.
+		 */
+		uint64_t rxOverflowCount() const
+		{
+			return m_rx_overflows.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Gets the number of received frames waiting for dispatch.
+		 * 
+		 * @return Current receive queue depth.
+		 */
+		size_t rxQueueDepth() const
+		{
+			return m_rx_queue.size();
+		}
+
+	protected:
+		/**
+		 * @brief Opens and configures the descriptor stored in m_fd.
+		 * 
+		 * The default implementation opens SerialConfig::port and applies the
+		 * termios settings. Subclasses override it to attach a different kind of
+		 * stream descriptor to the same framing and I/O path.
+		 * 
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		virtual ErrorCode openDescriptor();
+
+		/**
+		 * @brief Writes queued transmit segments to m_fd.
+		 * 
+		 * @param iov Segments to write.
+		 * @param iov_count Number of entries in iov.
+		 * 
+		 * @return Number of bytes written, or -1 with errno set.
+		 */
+		virtual ssize_t writeSegments(const struct iovec *iov, int iov_count);
+
+		/**
+		 * @brief Starts the I/O threads for a freshly configured port.
+		 * 
+		 * The default implementation starts the writer thread and either registers
+		 * with the reactor or starts the receive and dispatch threads. Subclasses
+		 * can override it to drive the port with a different I/O backend.
+		 * 
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		virtual ErrorCode startIo();
+
+		/**
+		 * @brief Stops whatever startIo() started.
+		 */
+		virtual void stopIo();
+
+		/**
+		 * @brief Called after bytes were added to the transmit ring, without the transmit lock held.
+		 * 
+		 * The default implementation wakes the writer thread.
+		 */
+		virtual void onTransmitQueued();
+
+		/**
+		 * @brief Fills iov with the readable segments of the transmit ring.
+		 * 
+		 * Must be called with mtxTransmit held.
+		 * 
+		 * @param iov Array with room for two entries.
+		 * 
+		 * @return Number of entries filled.
+		 */
+		int transmitSegments(struct iovec *iov);
+
+		/**
+		 * @brief Releases written bytes from the transmit ring and runs finished completions.
+		 * 
+		 * @param written Number of bytes the last write accepted.
+		 * @param failed Whether the port failed; all queued bytes are then dropped.
+		 */
+		void finishTransmit(size_t written, bool failed);
+
+		/**
+		 * @brief Reports the timing of written frames that have left the driver's output queue.
+		 * 
+		 * Compares the written byte count with TIOCOUTQ. Called from the writer
+		 * thread only.
+		 * 
+		 * @param flush Report every remaining frame, with drained left at 0 if still queued.
+		 * 
+		 * @return Whether frames are still waiting to drain.
+		 */
+		bool reportDrained(bool flush);
+
+		/**
+		 * @enum PollResult
+		 * @brief Outcome of waiting on the receive event loop.
+		 */
+		enum class PollResult
+		{
+			Readable,
+			Shutdown,
+			Timeout,
+			Error,
+		};
+
 		/**
 		 * @brief Starts the asynchronous receive thread.
 		 */
@@ -107,38 +351,247 @@ namespace wm::transport
 			m_thread = std::thread(&UartTransport::receiveThread, this);
 		};
 
+		/**
+		 * @brief Wakes the receive thread through the shutdown eventfd and joins it.
+		 */
+		void stopReceiveThread();
+
+		/**
+		 * @brief Starts the writer thread draining the transmit ring.
+		 */
+		void startTransmitThread();
+
+		/**
+		 * @brief Lets the writer flush what is queued, then stops and joins it.
+		 *
+		 * A full port is waited for as during normal operation, so this can
+		 * take up to write_timeout_ms after the port last accepted data;
+		 * whatever is still queued then is dropped.
+		 */
+		void stopTransmitThread();
+
+		/**
+		 * @brief Main loop for the writer thread.
+		 * 
+		 * Waits for queued data and writes the whole readable part of the
+		 * transmit ring with one writev(), then runs the completion callbacks
+		 * of every send that has been fully written. Partial writes leave the
+		 * rest queued; while the port accepts nothing the writer polls for
+		 * POLLOUT, and after write_timeout_ms without progress the queued data
+		 * is dropped and its sends complete with -1.
+		 */
+		void transmitThread();
+
+		/**
+		 * @brief Copies data, framed for the wire, into the transmit ring and wakes the writer.
+		 * 
+		 * @param data Pointer to the data buffer to send.
+		 * @param length Number of bytes to send.
+		 * @param on_complete Optional completion callback.
+		 */
+		void enqueueTransmit(const char *data, size_t length, SendCallback on_complete);
+
+		/**
+		 * @brief Waits until the transmit ring can hold length more bytes.
+		 * 
+		 * @param length Number of bytes about to be queued.
+		 * 
+		 * @return The held transmit lock.
+		 * 
+		 * @throws PortException If the port closes or length exceeds the ring capacity.
+		 * @throws TimeoutException If no space frees up within write_timeout_ms.
+		 */
+		std::unique_lock<std::mutex> waitTransmitSpace(size_t length);
+
+		/**
+		 * @brief Records freshly written bytes as queued and wakes the writer.
+		 * 
+		 * @param lock The transmit lock returned by waitTransmitSpace(); released on return.
+		 * @param wire_length Number of bytes added to the ring, including framing.
+		 * @param length Number of data bytes they carry; reported to on_complete.
+		 * @param on_complete Optional completion callback.
+		 */
+		void commitTransmit(std::unique_lock<std::mutex> &lock, size_t wire_length, size_t length, SendCallback on_complete);
+
+		/**
+		 * @brief Starts the thread delivering queued frames to subscribers.
+		 */
+		void startDispatchThread();
+
+		/**
+		 * @brief Stops and joins the dispatch thread, discarding undelivered frames.
+		 */
+		void stopDispatchThread();
+
+		/**
+		 * @brief Main loop for the dispatch thread.
+		 * 
+		 * Waits on the receive queue and notifies subscribers for each queued
+		 * frame, in batches, without blocking the receive thread.
+		 */
+		void dispatchThread();
+
 		/**
 		 * @brief Main loop for the receive thread.
 		 * 
-		 * Continuously monitors the serial port for incoming data,
-		 * deserializes messages, and notifies subscribers.
+		 * Sleeps in epoll_wait() until the serial port becomes readable or a
+		 * shutdown is requested, drains the port into the receive ring and
+		 * dispatches every complete frame found there.
 		 */
 		void receiveThread();
 
-	private:
-		/// @brief Queue for buffering received messages.
-		std::queue<ByteBuffer> m_rx_queue;
+		/**
+		 * @brief Creates the epoll set watching the port and the shutdown eventfd.
+		 * 
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode setupEventLoop();
+
+		/**
+		 * @brief Closes the epoll and eventfd descriptors.
+		 */
+		void teardownEventLoop();
+
+		/**
+		 * @brief Blocks until the port is readable, shutdown is signalled or the timeout expires.
+		 * 
+		 * @param timeout_ms Timeout in milliseconds, -1 waits indefinitely.
+		 * 
+		 * @return The PollResult describing why the wait finished.
+		 */
+		PollResult waitForEvent(int timeout_ms);
+
+		/**
+		 * @brief Reads every byte currently available on the port into the receive ring.
+		 * 
+		 * Uses a single readv() over the free segments of the ring.
+		 * 
+		 * @return Number of bytes read, 0 if nothing was pending, or negative on error or end of stream.
+		 */
+		ssize_t readIntoRing();
+
+		/**
+		 * @brief Extracts the complete frames from the receive ring after a read.
+		 * 
+		 * Stamps each frame with the time its first byte was read: frames that
+		 * started in bytes left over from an earlier read get that read's time.
+		 * 
+		 * @param bytes_read Number of bytes the read just added to the ring.
+		 * @param read_time When the read returned.
+		 * 
+		 * @return Number of frames extracted.
+		 */
+		size_t extractFrames(size_t bytes_read, Timestamp read_time);
+
+		/**
+		 * @brief Decodes a complete frame and hands it on.
+		 * 
+		 * Decodes through the bound protocol adapter and pushes the messages onto
+		 * the receive queue, or in reactor mode notifies subscribers directly.
+		 * 
+		 * @param frame Pointer to the frame bytes (starting with the length byte).
+		 * @param length Size of the frame in bytes.
+		 * @param received When the first byte of the frame was read.
+		 */
+		void handleFrame(const char *frame, size_t length, Timestamp received);
+
+		/// @brief Maximum number of frames delivered per dispatch wake-up.
+		static constexpr size_t RX_DISPATCH_BATCH = 32;
+		/// @brief How often TIOCOUTQ is polled while written frames wait to drain (timing hook only).
+		static constexpr std::chrono::milliseconds DRAIN_POLL_INTERVAL{1};
+
+		/// @brief Received messages waiting for the dispatch thread.
+		SpscQueue<Message> m_rx_queue;
+		/// @brief Frames dropped because m_rx_queue was full.
+		std::atomic<uint64_t> m_rx_overflows{0};
+		/// @brief The dispatch thread object.
+		std::thread m_dispatch_thread;
+		/// @brief Set by close() to stop the dispatch thread.
+		std::atomic<bool> m_dispatch_stop{false};
 
-		/// @brief Timeout for receive thread operations in milliseconds.
-		uint16_t thread_timeout = 1;
 		/// @brief The receive thread object.
 		std::thread m_thread;
 
-		/// @brief Receive buffer (RX_BUFF_SIZE bytes).
-		char rx_buff[RX_BUFF_SIZE] = {0};
-		/// @brief Transmit buffer (TX_BUFF_SIZE bytes).
-		char tx_buff[TX_BUFF_SIZE] = {0};
+		/// @brief Reactor servicing this transport, or nullptr for private threads.
+		TransportReactor *m_reactor{nullptr};
+		/// @brief Time of the last read in reactor mode, used to expire partial frames.
+		std::chrono::steady_clock::time_point m_last_rx;
 
-		/// @brief Mutex protecting the receive queue.
-		std::mutex mtxReceive;
+		/// @brief epoll instance watching m_fd and m_wake_fd (-1 if not open).
+		int m_epoll_fd{-1};
+		/// @brief eventfd used to wake the receive thread on close (-1 if not open).
+		int m_wake_fd{-1};
+
+		/// @brief Receive ring sized from SerialConfig::rx_buffer_size.
+		RingBuffer m_rx_ring;
+		/// @brief Splits the receive ring into frames according to SerialConfig::framing.
+		Framer m_framer;
+		/// @brief Read time of the oldest bytes left in the receive ring by extractFrames().
+		Timestamp m_rx_partial_since{0};
+
+		/**
+		 * @struct PendingSend
+		 * @brief Completion record for a queued send.
+		 */
+		struct PendingSend
+		{
+			/// @brief Stream position just past the last byte of this send.
+			uint64_t end_offset;
+			/// @brief Number of bytes in this send.
+			int length;
+			/// @brief Callback to run once the send is written.
+			SendCallback on_complete;
+			/// @brief When the send was queued, 0 without a timing hook.
+			Timestamp queued;
+		};
+
+		/// @brief The writer thread object.
+		std::thread m_tx_thread;
+		/// @brief Transmit ring sized from SerialConfig::tx_buffer_size.
+		RingBuffer m_tx_ring;
+		/// @brief Completion records ordered by end_offset.
+		std::deque<PendingSend> m_tx_pending;
+		/// @brief Total bytes ever queued for transmission.
+		uint64_t m_tx_queued_total{0};
+		/// @brief Total bytes ever written (or discarded after an error).
+		uint64_t m_tx_written_total{0};
+		/// @brief Callbacks of fully written sends, collected by finishTransmit().
+		std::vector<std::pair<SendCallback, int>> m_tx_completed;
+		/// @brief Written frames still in the driver's output queue, keyed by end offset (writer thread only).
+		std::deque<std::pair<uint64_t, FrameTiming>> m_tx_draining;
+		/// @brief Set by close() to make the writer exit once the ring is drained.
+		std::atomic<bool> m_tx_stop{false};
+		/// @brief Mutex protecting the transmit ring and completion records.
+		mutable std::mutex mtxTransmit;
+		/// @brief Signalled when data is queued or a stop is requested.
+		std::condition_variable m_tx_data_cv;
+		/// @brief Signalled when the writer frees space in the transmit ring.
+		std::condition_variable m_tx_space_cv;
+
+		/// @brief Staging buffer for in-place frames that would wrap around the transmit ring.
+		char tx_buff[TX_BUFF_SIZE] = {0};
 
 		/// @brief File descriptor for the serial port (-1 if not open).
 		int m_fd{-1};
+		/// @brief Line rate read back from the driver by configure_unix().
+		uint32_t m_actual_baudrate{0};
+
+	private:
 		/**
 		 * @brief Configures the UNIX serial port with termios settings.
 		 * 
 		 * @return ErrorCode indicating success or the specific error.
 		 */
 		ErrorCode configure_unix();
+
+		/**
+		 * @brief Applies the driver side of SerialConfig::latency_profile.
+		 * 
+		 * Sets or clears ASYNC_LOW_LATENCY through TIOCSSERIAL and, for USB-serial
+		 * adapters with a writable sysfs latency_timer, sets it to 1 ms (LowLatency)
+		 * or the 16 ms driver default (Throughput). Balanced leaves both untouched.
+		 * Ports that support neither are left as they are.
+		 */
+		void applyLatencyProfile();
 	};
 }
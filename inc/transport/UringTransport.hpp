@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "IoUring.hpp"
+#include "UartTransport.hpp"
+
+namespace wm::transport
+{
+	/**
+	 * @class UringTransport
+	 * @brief UART transport driven by io_uring instead of epoll and per-direction threads.
+	 *
+	 * A single ring thread keeps one read posted into the free tail of the
+	 * receive ring (registered once as a fixed buffer, so the kernel does not
+	 * map pages on every read) and one vectored write covering everything
+	 * queued in the transmit ring. Both are submitted and reaped with one
+	 * io_uring_enter() call per loop, and the writer is only woken through its
+	 * eventfd when the ring thread is actually asleep.
+	 *
+	 * The port stays non-blocking. Reads are linked behind a POLLIN poll, and a
+	 * write the driver cannot take waits in a POLLOUT poll, so every request
+	 * in flight can be cancelled when the port closes. Writes and write polls
+	 * carry a linked timeout: as in the epoll writer, queued data is dropped
+	 * and its sends complete with -1 once the port has accepted nothing for
+	 * write_timeout_ms. Closing flushes the queue under the same limit.
+	 *
+	 * Framing, the receive queue and subscriber dispatch are shared with
+	 * UartTransport. If io_uring cannot be set up, or a reactor is attached,
+	 * open() falls back to the epoll implementation.
+	 */
+	class UringTransport : public UartTransport
+	{
+	public:
+		/**
+		 * @brief Constructs a UringTransport with serial configuration.
+		 *
+		 * @param config Reference to a SerialConfig containing port and communication settings.
+		 */
+		UringTransport(const SerialConfig &config);
+
+		/**
+		 * @brief Destructor that closes the connection if open.
+		 */
+		~UringTransport() override;
+
+		/**
+		 * @brief Checks whether the port is currently driven by io_uring.
+		 *
+		 * @return true if open on the io_uring backend, false if closed or on the epoll fallback.
+		 */
+		bool usingIoUring() const { return m_ring != nullptr; }
+
+	protected:
+		/**
+		 * @brief Sets up the io_uring instance and starts the ring and dispatch threads.
+		 *
+		 * @return ErrorCode indicating success or the specific error.
+		 */
+		ErrorCode startIo() override;
+
+		/**
+		 * @brief Flushes queued data, cancels the pending read and joins the ring thread.
+		 */
+		void stopIo() override;
+
+		/**
+		 * @brief Wakes the ring thread if it is asleep so it can submit the write.
+		 */
+		void onTransmitQueued() override;
+
+	private:
+		/**
+		 * @enum Op
+		 * @brief Identifies an operation in the user_data field of its completion.
+		 */
+		enum Op : uint64_t
+		{
+			OpReadPoll = 1,
+			OpRead,
+			OpWritePoll,
+			OpWriteTimeout,
+			OpWrite,
+			OpWake,
+			OpTimeout,
+			OpDrain,
+			OpCancel,
+		};
+
+		/// @brief Submission queue entries; one loop never prepares more, so linked requests are never split.
+		static constexpr unsigned RING_ENTRIES = 16;
+
+		/**
+		 * @brief Main loop for the ring thread.
+		 */
+		void ringThread();
+
+		/**
+		 * @brief Posts a read into the free tail of the receive ring.
+		 */
+		void postRead();
+
+		/**
+		 * @brief Posts a vectored write of the queued transmit data, if any.
+		 */
+		void postWrite();
+
+		/**
+		 * @brief Handles a write the port accepted nothing from.
+		 *
+		 * Waits for POLLOUT until write_timeout_ms after the stall began, then
+		 * drops the queued data.
+		 */
+		void onWriteBlocked();
+
+		/**
+		 * @brief Gets the time left before a stalled write is given up.
+		 *
+		 * @return Time left, the full write_timeout_ms if not stalled.
+		 */
+		std::chrono::nanoseconds writeStallRemaining() const;
+
+		/**
+		 * @brief Posts a timeout linked to the write or write poll just prepared.
+		 */
+		void postWriteTimeout();
+
+		/**
+		 * @brief Posts a cancellation of an operation, if it is in flight.
+		 *
+		 * @param op The operation to cancel.
+		 */
+		void postCancel(Op op);
+
+		/**
+		 * @brief Checks whether any operation other than a cancellation is in flight.
+		 *
+		 * @return true if a completion is still outstanding.
+		 */
+		bool anyPosted() const;
+
+		/**
+		 * @brief Posts a read on the wake eventfd.
+		 */
+		void postWake();
+
+		/**
+		 * @brief Posts a timeout after which a pending partial frame is dropped.
+		 */
+		void postPartialFrameTimeout();
+
+		/**
+		 * @brief Posts a short timeout after which written frames are checked for having drained.
+		 */
+		void postDrainPoll();
+
+		/**
+		 * @brief Destroys the io_uring instance and closes the wake eventfd.
+		 */
+		void releaseRing();
+
+		/**
+		 * @brief Handles one completion.
+		 *
+		 * @param cqe The completion entry.
+		 */
+		void onCompletion(const struct io_uring_cqe &cqe);
+
+		/**
+		 * @brief Gets a submission entry, flushing the ring once if it is full.
+		 *
+		 * @return A zeroed entry.
+		 */
+		struct io_uring_sqe *nextSqe();
+
+		/// @brief The io_uring instance, or nullptr when not open on this backend.
+		std::unique_ptr<IoUring> m_ring;
+		/// @brief The ring thread object.
+		std::thread m_ring_thread;
+		/// @brief eventfd used to wake the ring thread for writes and shutdown.
+		int m_event_fd{-1};
+		/// @brief Target of the eventfd read.
+		uint64_t m_event_value{0};
+		/// @brief Set by stopIo() to make the ring thread flush and exit.
+		std::atomic<bool> m_ring_stop{false};
+		/// @brief Set while the ring thread sleeps in io_uring_enter() with no write pending.
+		std::atomic<bool> m_ring_idle{false};
+		/// @brief Set when the port was closed from the ring thread, which then releases the ring itself.
+		bool m_release_on_exit{false};
+
+		/// @brief Whether the poll ahead of the read is in flight.
+		bool m_read_poll_posted{false};
+		/// @brief Whether a read of the port is in flight.
+		bool m_read_posted{false};
+		/// @brief Whether a write is waiting for the port to become writable.
+		bool m_write_poll_posted{false};
+		/// @brief Number of timeouts linked to writes or write polls still in flight.
+		unsigned m_write_timeouts_posted{0};
+		/// @brief Whether a write is in flight.
+		bool m_write_posted{false};
+		/// @brief When the pending write was submitted.
+		std::chrono::steady_clock::time_point m_write_posted_at;
+		/// @brief When the port stopped accepting data, if it currently does not.
+		std::optional<std::chrono::steady_clock::time_point> m_write_stalled_since;
+		/// @brief Whether the eventfd read is in flight.
+		bool m_wake_posted{false};
+		/// @brief Whether a partial frame timeout is in flight.
+		bool m_timeout_posted{false};
+		/// @brief Whether a drain poll timeout is in flight.
+		bool m_drain_posted{false};
+		/// @brief Number of cancellations in flight.
+		unsigned m_cancels_posted{0};
+		/// @brief Number of completed port reads, used to tell whether a timeout is stale.
+		uint64_t m_read_count{0};
+		/// @brief Value of m_read_count when the pending timeout was posted.
+		uint64_t m_timeout_read_count{0};
+		/// @brief Segments of the transmit ring covered by the pending write.
+		struct iovec m_write_iov[2]{};
+		/// @brief Timeout of the pending partial frame timeout.
+		struct __kernel_timespec m_partial_timeout{};
+		/// @brief Timeout of the pending drain poll.
+		struct __kernel_timespec m_drain_timeout{};
+		/// @brief Timeout linked to the pending write or write poll.
+		struct __kernel_timespec m_write_timeout{};
+	};
+
+	/**
+	 * @brief Creates the serial transport selected by SerialConfig::io_backend.
+	 *
+	 * Requests for io_uring fall back to the epoll implementation when the
+	 * running kernel does not support it.
+	 *
+	 * @param config Serial configuration.
+	 *
+	 * @return The transport, not yet opened.
+	 */
+	std::unique_ptr<UartTransport> createSerialTransport(const SerialConfig &config);
+}
@@ -41,9 +41,7 @@ void LedControllerDevice::turnOn()
         std::vector<char> cmdData = {LedCommand::TurnOn, m_ledPin.getPinChar(), m_ledPin.getPort()};
 
         auto cmd = m_protocol->createCommand(cmdData);
-        auto encoded = m_protocol->encode(cmd);
-
-        m_transport->send(encoded.data(), encoded.size());
+        sendMessage(cmd);
         std::cout << TAG << "Turn On command sent" << std::endl;
     }
     catch (const std::exception &e)
@@ -59,9 +57,7 @@ void LedControllerDevice::turnOff()
         std::vector<char> cmdData = {LedCommand::TurnOff, m_ledPin.getPinChar(), m_ledPin.getPort()};
 
         auto cmd = m_protocol->createCommand(cmdData);
-        auto encoded = m_protocol->encode(cmd);
-
-        m_transport->send(encoded.data(), encoded.size());
+        sendMessage(cmd);
         std::cout << TAG << "Turn Off command sent" << std::endl;
     }
     catch (const std::exception &e)
@@ -77,8 +73,7 @@ void LedControllerDevice::setBrightness(uint8_t level)
         std::vector<char> cmdData = {LedCommand::SetBrightness, m_ledPin.getPinChar(), m_ledPin.getPort(), static_cast<char>(level)};
 
         auto cmd = m_protocol->createCommand(cmdData);
-        auto encoded = m_protocol->encode(cmd);
-        m_transport->send(encoded.data(), encoded.size());
+        sendMessage(cmd);
         std::cout << TAG << "Set Brightness command sent with level: " << level << std::endl;
     }
     catch (const std::exception &e)
@@ -9,8 +9,12 @@ TestDevice::TestDevice(transport::ITransport *transport, protoc::IProtocolAdapte
     : IDevice(protocol, transport)
 
 {
-    transport->subscribeReceive([this](const Message &mes)
-                                { this->onNotifyReceive(mes); });
+    // Printing every frame is slow; keep it off the receive path.
+    transport::SubscribeOptions options;
+    options.mode = transport::DispatchMode::Serial;
+    options.name = "test-device";
+    m_subscription = transport->subscribeReceive([this](const MessageView &mes)
+                                                 { this->onNotifyReceive(mes); }, options);
 }
 
 void TestDevice::connect()
@@ -46,13 +50,20 @@ bool TestDevice::sendTestMessage(uint32_t idx, MessageType type, const std::vect
 
     try
     {
-        Message msg(idx, type, VectorChar(data));
-        auto encoded = m_protocol->encode(msg);
-        return sendRaw(encoded);
+        Message msg(idx, type, Payload(data));
+        int bytes_sent = sendMessage(msg);
+        if (bytes_sent <= 0)
+        {
+            std::cout << TAG << "Send failed: " << bytes_sent << std::endl;
+            return false;
+        }
+
+        std::cout << TAG << "Sent message " << idx << " (" << bytes_sent << " bytes)" << std::endl;
+        return true;
     }
     catch (const std::exception &e)
     {
-        std::cout << TAG << "Error encoding message: " << e.what() << std::endl;
+        std::cout << TAG << "Error sending message: " << e.what() << std::endl;
         return false;
     }
 }
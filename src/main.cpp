@@ -157,6 +157,11 @@ int main(int argc, char *argv[])
 			protocol_choice = "shift";
 			device_choice = "test";
 		}
+		else if (arg1 == "crc16" || arg1 == "crc32c")
+		{
+			protocol_choice = arg1;
+			device_choice = "test";
+		}
 		else
 		{
 			protocol_choice = "plain";
@@ -168,7 +173,7 @@ int main(int argc, char *argv[])
 		string arg1 = argv[1];
 		string arg2 = argv[2];
 
-		if (arg1 == "plain" || arg1 == "shift")
+		if (arg1 == "plain" || arg1 == "shift" || arg1 == "crc16" || arg1 == "crc32c")
 		{
 			protocol_choice = arg1;
 			device_choice = arg2;
@@ -201,12 +206,19 @@ int main(int argc, char *argv[])
 		std::cout << "Using ShiftProtocol with shift value: 0x" << std::hex << shift_value << std::dec << std::endl;
 		protocol = new ShiftProtocol(shift_value);
 	}
+	else if (protocol_choice == "crc16" || protocol_choice == "crc32c")
+	{
+		std::cout << "Using ChecksumProtocol with " << protocol_choice << std::endl;
+		protocol = new ChecksumProtocol(protocol_choice == "crc16" ? ChecksumType::Crc16Ccitt : ChecksumType::Crc32C);
+	}
 	else
 	{
 		std::cout << "Using PlainProtocol" << std::endl;
 		protocol = new PlainProtocol();
 	}
 
+	uart_transport.bindProtocol(protocol);
+
 	if (device_choice == "led")
 	{
 		runLedController(&uart_transport, protocol);
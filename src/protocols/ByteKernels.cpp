@@ -0,0 +1,226 @@
+#include "protocols/ByteKernels.hpp"
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WM_BYTE_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace wm::protoc
+{
+    namespace
+    {
+        enum class Isa
+        {
+            Scalar,
+            Avx2,
+            Avx512Vbmi,
+        };
+
+        Isa detect_isa()
+        {
+#ifdef WM_BYTE_KERNELS_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw"))
+            {
+                return Isa::Avx512Vbmi;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return Isa::Avx2;
+            }
+#endif
+            return Isa::Scalar;
+        }
+
+        Isa detected_isa()
+        {
+            static const Isa detected = detect_isa();
+            return detected;
+        }
+
+        std::atomic<Isa> &selected_isa()
+        {
+            static std::atomic<Isa> selected{detected_isa()};
+            return selected;
+        }
+
+        Isa isa()
+        {
+            return selected_isa().load(std::memory_order_relaxed);
+        }
+
+        void add_scalar(const char *src, char *dst, size_t size, uint8_t delta)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                dst[i] = static_cast<char>(static_cast<uint8_t>(src[i]) + delta);
+            }
+        }
+
+        void substitute_scalar(const char *src, char *dst, size_t size, const SubstitutionTable &table)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                dst[i] = static_cast<char>(table.bytes[static_cast<uint8_t>(src[i])]);
+            }
+        }
+
+#ifdef WM_BYTE_KERNELS_X86
+        // 128-bit pshufb is no faster than the scalar lookup, so substitution is
+        // vectorized from AVX2 up.
+        //
+        // pshufb looks up the low nibble and yields 0 when bit 7 of the index is set.
+        // For a byte below 0x80, indexing row k of SubstitutionTable::row_diffs with
+        // (byte - 16 * k) hits rows 0..high only, and their XOR cancels down to
+        // row[high]. Bytes from 0x80 are looked up in the upper half with bit 7 flipped.
+        __attribute__((target("avx2"))) __m256i lookup_half_avx2(const __m256i *rows, __m256i index)
+        {
+            const __m256i step = _mm256_set1_epi8(16);
+            __m256i result = _mm256_shuffle_epi8(rows[0], index);
+            for (int row = 1; row < 8; ++row)
+            {
+                index = _mm256_sub_epi8(index, step);
+                result = _mm256_xor_si256(result, _mm256_shuffle_epi8(rows[row], index));
+            }
+            return result;
+        }
+
+        __attribute__((target("avx2"))) void substitute_avx2(const char *src, char *dst, size_t size, const SubstitutionTable &table)
+        {
+            __m256i rows[16];
+            for (int row = 0; row < 16; ++row)
+            {
+                rows[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(table.row_diffs.data() + 16 * row)));
+            }
+
+            const __m256i top_bit = _mm256_set1_epi8(static_cast<char>(0x80));
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+            {
+                __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                __m256i low = lookup_half_avx2(rows, bytes);
+                __m256i high = lookup_half_avx2(rows + 8, _mm256_xor_si256(bytes, top_bit));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_blendv_epi8(low, high, bytes));
+            }
+            substitute_scalar(src + i, dst + i, size - i, table);
+        }
+
+        // vpermi2b looks up 7 index bits across two 64-byte registers, so two of
+        // them cover the table and bit 7 of each byte picks between the halves.
+        __attribute__((target("avx512bw,avx512vbmi"))) void substitute_avx512(const char *src, char *dst, size_t size, const SubstitutionTable &table)
+        {
+            const __m512i quarter0 = _mm512_loadu_si512(table.bytes.data());
+            const __m512i quarter1 = _mm512_loadu_si512(table.bytes.data() + 64);
+            const __m512i quarter2 = _mm512_loadu_si512(table.bytes.data() + 128);
+            const __m512i quarter3 = _mm512_loadu_si512(table.bytes.data() + 192);
+
+            for (size_t i = 0; i < size; i += 64)
+            {
+                __mmask64 lanes = size - i >= 64 ? ~__mmask64(0) : (__mmask64(1) << (size - i)) - 1;
+                __m512i index = _mm512_maskz_loadu_epi8(lanes, src + i);
+                __m512i low = _mm512_permutex2var_epi8(quarter0, index, quarter1);
+                __m512i high = _mm512_permutex2var_epi8(quarter2, index, quarter3);
+                _mm512_mask_storeu_epi8(dst + i, lanes, _mm512_mask_blend_epi8(_mm512_movepi8_mask(index), low, high));
+            }
+        }
+#endif
+    }
+
+    SubstitutionTable::SubstitutionTable(const ByteTable &table) : bytes(table), row_diffs{}
+    {
+        for (size_t row = 0; row < 16; ++row)
+        {
+            for (size_t low = 0; low < 16; ++low)
+            {
+                uint8_t value = table[16 * row + low];
+                if (row % 8 != 0)
+                {
+                    value ^= table[16 * (row - 1) + low];
+                }
+                row_diffs[16 * row + low] = value;
+            }
+        }
+    }
+
+    ByteTable invert_byte_table(const ByteTable &table)
+    {
+        ByteTable inverse{};
+        std::array<bool, 256> seen{};
+        for (size_t value = 0; value < table.size(); ++value)
+        {
+            uint8_t encoded = table[value];
+            if (seen[encoded])
+            {
+                throw std::invalid_argument("Substitution table is not a permutation");
+            }
+            seen[encoded] = true;
+            inverse[encoded] = static_cast<uint8_t>(value);
+        }
+        return inverse;
+    }
+
+    void add_bytes(const char *src, char *dst, size_t size, uint8_t delta)
+    {
+        // The compiler vectorizes this loop; hand-written SSE2/AVX2 versions
+        // measured slower with hardware_proto_bench bytes, so nothing to dispatch.
+        add_scalar(src, dst, size, delta);
+    }
+
+    void substitute_bytes(const char *src, char *dst, size_t size, const SubstitutionTable &table)
+    {
+#ifdef WM_BYTE_KERNELS_X86
+        switch (isa())
+        {
+        case Isa::Avx512Vbmi:
+            substitute_avx512(src, dst, size, table);
+            return;
+        case Isa::Avx2:
+            substitute_avx2(src, dst, size, table);
+            return;
+        case Isa::Scalar:
+            break;
+        }
+#endif
+        substitute_scalar(src, dst, size, table);
+    }
+
+    const char *byte_kernels_isa()
+    {
+        switch (isa())
+        {
+        case Isa::Avx512Vbmi:
+            return "avx512vbmi";
+        case Isa::Avx2:
+            return "avx2";
+        default:
+            return "scalar";
+        }
+    }
+
+    bool set_byte_kernels_isa(const char *isa)
+    {
+        static const std::pair<const char *, Isa> names[] = {
+            {"avx512vbmi", Isa::Avx512Vbmi},
+            {"avx2", Isa::Avx2},
+            {"scalar", Isa::Scalar},
+        };
+
+        for (const auto &[name, value] : names)
+        {
+            if (std::strcmp(isa, name) == 0)
+            {
+                // The enumerators are ordered, so anything up to the detected level runs here.
+                if (value > detected_isa())
+                {
+                    return false;
+                }
+                selected_isa().store(value, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+}
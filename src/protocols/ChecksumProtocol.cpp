@@ -0,0 +1,69 @@
+#include "protocols/ChecksumProtocol.hpp"
+#include "protocols/Crc.hpp"
+#include <stdexcept>
+
+using namespace wm::protoc;
+
+size_t ChecksumProtocol::encodeInto(const Message &mes, std::span<char> out)
+{
+    size_t checksum_size = checksumSize();
+    if (mes.serializedSize() + checksum_size > MessageView::MAX_SIZE)
+        throw std::runtime_error("Message too large to append a checksum");
+    if (out.size() < encodedSize(mes))
+        throw std::runtime_error("Output buffer too small for message and checksum");
+
+    size_t size = mes.serializeInto(out);
+    out[0] = static_cast<char>(static_cast<uint8_t>(out[0]) + checksum_size);
+
+    uint32_t checksum = compute(out.data(), size);
+    for (size_t i = 0; i < checksum_size; ++i)
+    {
+        out[size + i] = static_cast<char>(checksum >> (8 * (checksum_size - 1 - i)));
+    }
+
+    return size + checksum_size;
+}
+
+Message ChecksumProtocol::decode(const char *data, size_t size)
+{
+    return verify(data, size).toOwned();
+}
+
+size_t ChecksumProtocol::feed(std::span<const char> data, const MessageSink &on_message)
+{
+    on_message(verify(data.data(), data.size()));
+    return 1;
+}
+
+uint32_t ChecksumProtocol::compute(const char *data, size_t size) const
+{
+    if (m_type == ChecksumType::Crc16Ccitt)
+    {
+        return crc16_ccitt(data, size);
+    }
+    return crc32c(data, size);
+}
+
+MessageView ChecksumProtocol::verify(const char *data, size_t size) const
+{
+    MessageView mes = MessageView::decode(data, size);
+
+    size_t checksum_size = checksumSize();
+    if (mes.data.size() < checksum_size)
+        throw std::runtime_error("Frame too short for its checksum");
+
+    size_t covered = static_cast<size_t>(mes.len) + 1 - checksum_size;
+    const auto *trailer = reinterpret_cast<const uint8_t *>(data + covered);
+    uint32_t received = 0;
+    for (size_t i = 0; i < checksum_size; ++i)
+    {
+        received = (received << 8) | trailer[i];
+    }
+
+    if (received != compute(data, covered))
+        throw wm::transport::ChecksumException();
+
+    mes.len = static_cast<uint8_t>(mes.len - checksum_size);
+    mes.data = mes.data.first(mes.data.size() - checksum_size);
+    return mes;
+}
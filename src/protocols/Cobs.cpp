@@ -0,0 +1,82 @@
+#include "protocols/Cobs.hpp"
+#include <cstring>
+
+namespace wm::protoc
+{
+    size_t cobs_encode(const char *src, size_t length, char *dst, CobsVariant variant)
+    {
+        size_t code_pos = 0;
+        size_t out = 1;
+        uint8_t code = 1;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (src[i] == 0)
+            {
+                dst[code_pos] = static_cast<char>(code);
+                code_pos = out++;
+                code = 1;
+                continue;
+            }
+
+            dst[out++] = src[i];
+            if (++code == 0xFF)
+            {
+                dst[code_pos] = static_cast<char>(code);
+                code_pos = out++;
+                code = 1;
+            }
+        }
+
+        // COBS/R: a last byte larger than the final code stands in for it, and the
+        // decoder recognises it by the code pointing past the end of the frame.
+        if (variant == CobsVariant::CobsR && code > 1 && static_cast<uint8_t>(dst[out - 1]) > code)
+        {
+            dst[code_pos] = dst[out - 1];
+            return out - 1;
+        }
+
+        dst[code_pos] = static_cast<char>(code);
+        return out;
+    }
+
+    std::optional<size_t> cobs_decode(char *buffer, size_t size, CobsVariant variant)
+    {
+        size_t in = 0;
+        size_t out = 0;
+
+        while (in < size)
+        {
+            uint8_t code = static_cast<uint8_t>(buffer[in++]);
+            if (code == 0)
+            {
+                return std::nullopt;
+            }
+
+            size_t block = code - 1u;
+            if (block > size - in)
+            {
+                if (variant != CobsVariant::CobsR)
+                {
+                    return std::nullopt;
+                }
+
+                std::memmove(buffer + out, buffer + in, size - in);
+                out += size - in;
+                buffer[out++] = static_cast<char>(code);
+                return out;
+            }
+
+            std::memmove(buffer + out, buffer + in, block);
+            out += block;
+            in += block;
+
+            if (code != 0xFF && in < size)
+            {
+                buffer[out++] = 0;
+            }
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,196 @@
+#include "protocols/Crc.hpp"
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WM_CRC_X86 1
+#include <immintrin.h>
+#endif
+
+namespace wm::protoc
+{
+    namespace
+    {
+        using SliceTables = std::array<std::array<uint16_t, 256>, 8>;
+        using SliceTables32 = std::array<std::array<uint32_t, 256>, 8>;
+
+        // tables[k][b] is the CRC contribution of byte b followed by k zero bytes.
+        constexpr SliceTables make_crc16_tables()
+        {
+            SliceTables tables{};
+            for (uint32_t byte = 0; byte < 256; ++byte)
+            {
+                uint16_t crc = static_cast<uint16_t>(byte << 8);
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+                }
+                tables[0][byte] = crc;
+            }
+            for (size_t k = 1; k < 8; ++k)
+            {
+                for (size_t byte = 0; byte < 256; ++byte)
+                {
+                    uint16_t prev = tables[k - 1][byte];
+                    tables[k][byte] = static_cast<uint16_t>((prev << 8) ^ tables[0][prev >> 8]);
+                }
+            }
+            return tables;
+        }
+
+        constexpr SliceTables32 make_crc32c_tables()
+        {
+            SliceTables32 tables{};
+            for (uint32_t byte = 0; byte < 256; ++byte)
+            {
+                uint32_t crc = byte;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+                }
+                tables[0][byte] = crc;
+            }
+            for (size_t k = 1; k < 8; ++k)
+            {
+                for (size_t byte = 0; byte < 256; ++byte)
+                {
+                    uint32_t prev = tables[k - 1][byte];
+                    tables[k][byte] = (prev >> 8) ^ tables[0][prev & 0xFF];
+                }
+            }
+            return tables;
+        }
+
+        constexpr SliceTables CRC16_TABLES = make_crc16_tables();
+        constexpr SliceTables32 CRC32C_TABLES = make_crc32c_tables();
+
+        uint32_t crc32c_slice8(const uint8_t *bytes, size_t size, uint32_t crc)
+        {
+            const auto &t = CRC32C_TABLES;
+            while (size >= 8)
+            {
+                uint32_t low;
+                uint32_t high;
+                std::memcpy(&low, bytes, 4);
+                std::memcpy(&high, bytes + 4, 4);
+                low ^= crc;
+                crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+                      t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+                bytes += 8;
+                size -= 8;
+            }
+            while (size-- > 0)
+            {
+                crc = (crc >> 8) ^ t[0][(crc ^ *bytes++) & 0xFF];
+            }
+            return crc;
+        }
+
+#ifdef WM_CRC_X86
+        __attribute__((target("sse4.2"))) uint32_t crc32c_sse42(const uint8_t *bytes, size_t size, uint32_t crc)
+        {
+#ifdef __x86_64__
+            uint64_t crc64 = crc;
+            while (size >= 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, bytes, 8);
+                crc64 = _mm_crc32_u64(crc64, word);
+                bytes += 8;
+                size -= 8;
+            }
+            crc = static_cast<uint32_t>(crc64);
+#endif
+            while (size >= 4)
+            {
+                uint32_t word;
+                std::memcpy(&word, bytes, 4);
+                crc = _mm_crc32_u32(crc, word);
+                bytes += 4;
+                size -= 4;
+            }
+            while (size-- > 0)
+            {
+                crc = _mm_crc32_u8(crc, *bytes++);
+            }
+            return crc;
+        }
+#endif
+
+        using Crc32cKernel = uint32_t (*)(const uint8_t *, size_t, uint32_t);
+
+        Crc32cKernel select_crc32c()
+        {
+#ifdef WM_CRC_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("sse4.2"))
+            {
+                return crc32c_sse42;
+            }
+#endif
+            return crc32c_slice8;
+        }
+
+        Crc32cKernel detected_crc32c()
+        {
+            static const Crc32cKernel kernel = select_crc32c();
+            return kernel;
+        }
+
+        std::atomic<Crc32cKernel> &selected_crc32c()
+        {
+            static std::atomic<Crc32cKernel> selected{detected_crc32c()};
+            return selected;
+        }
+
+        Crc32cKernel crc32c_kernel()
+        {
+            return selected_crc32c().load(std::memory_order_relaxed);
+        }
+    }
+
+    uint16_t crc16_ccitt(const char *data, size_t size, uint16_t crc)
+    {
+        const auto &t = CRC16_TABLES;
+        const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+        while (size >= 8)
+        {
+            crc = static_cast<uint16_t>(t[7][bytes[0] ^ (crc >> 8)] ^ t[6][bytes[1] ^ (crc & 0xFF)] ^
+                                        t[5][bytes[2]] ^ t[4][bytes[3]] ^ t[3][bytes[4]] ^ t[2][bytes[5]] ^
+                                        t[1][bytes[6]] ^ t[0][bytes[7]]);
+            bytes += 8;
+            size -= 8;
+        }
+        while (size-- > 0)
+        {
+            crc = static_cast<uint16_t>((crc << 8) ^ t[0][(crc >> 8) ^ *bytes++]);
+        }
+        return crc;
+    }
+
+    uint32_t crc32c(const char *data, size_t size, uint32_t crc)
+    {
+        return ~crc32c_kernel()(reinterpret_cast<const uint8_t *>(data), size, ~crc);
+    }
+
+    const char *crc32c_isa()
+    {
+        return crc32c_kernel() == crc32c_slice8 ? "slice-by-8" : "sse4.2";
+    }
+
+    bool set_crc32c_isa(const char *isa)
+    {
+        if (std::strcmp(isa, "slice-by-8") == 0)
+        {
+            selected_crc32c().store(crc32c_slice8, std::memory_order_relaxed);
+            return true;
+        }
+        if (std::strcmp(isa, "sse4.2") == 0 && detected_crc32c() != crc32c_slice8)
+        {
+            selected_crc32c().store(detected_crc32c(), std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+}
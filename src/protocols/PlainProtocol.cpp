@@ -2,13 +2,18 @@
 
 using namespace wm::protoc;
 
-std::vector<char> PlainProtocol::encode(const Message &mes)
+size_t PlainProtocol::encodeInto(const Message &mes, std::span<char> out)
 {
-    auto serialized = mes.serialize();
-    return serialized;
+    return mes.serializeInto(out);
 }
 
 Message PlainProtocol::decode(const char *data, size_t size)
 {
     return Message::deserialize(data, size);
 }
+
+size_t PlainProtocol::feed(std::span<const char> data, const MessageSink &on_message)
+{
+    on_message(MessageView::decode(data.data(), data.size()));
+    return 1;
+}
@@ -0,0 +1,58 @@
+#include "protocols/ProtocolPipeline.hpp"
+#include <stdexcept>
+
+using namespace wm::protoc;
+
+ProtocolPipeline &ProtocolPipeline::add(std::unique_ptr<IProtocolStage> stage)
+{
+    if (!stage)
+        throw std::invalid_argument("Protocol stage must not be null");
+
+    m_overhead += stage->overhead();
+    m_stages.push_back(std::move(stage));
+    return *this;
+}
+
+size_t ProtocolPipeline::encodeInto(const Message &mes, std::span<char> out)
+{
+    if (encodedSize(mes) > MessageView::MAX_SIZE)
+        throw std::runtime_error("Message too large for the protocol stages");
+
+    FrameBuffer frame{out.data(), mes.serializeInto(out), out.size()};
+    for (const auto &stage : m_stages)
+    {
+        stage->encode(frame);
+    }
+    return frame.size;
+}
+
+Message ProtocolPipeline::decode(const char *data, size_t size)
+{
+    char buffer[MessageView::MAX_SIZE];
+    FrameBuffer frame = copy_frame(data, size, buffer);
+    decodeStages(frame);
+    return Message::deserialize(frame.data, frame.size);
+}
+
+size_t ProtocolPipeline::feed(std::span<const char> data, const MessageSink &on_message)
+{
+    if (m_stages.empty())
+    {
+        on_message(MessageView::decode(data.data(), data.size()));
+        return 1;
+    }
+
+    char buffer[MessageView::MAX_SIZE];
+    FrameBuffer frame = copy_frame(data.data(), data.size(), buffer);
+    decodeStages(frame);
+    on_message(MessageView::decode(frame.data, frame.size));
+    return 1;
+}
+
+void ProtocolPipeline::decodeStages(FrameBuffer &frame) const
+{
+    for (auto it = m_stages.rbegin(); it != m_stages.rend(); ++it)
+    {
+        (*it)->decode(frame);
+    }
+}
@@ -0,0 +1,7 @@
+#include "protocols/ProtocolStage.hpp"
+
+using namespace wm::protoc;
+
+SubstitutionStage::SubstitutionStage(const ByteTable &table) : m_encode(table), m_decode(invert_byte_table(table))
+{
+}
@@ -1,49 +1,34 @@
 #include "protocols/ShiftProtocol.hpp"
+#include "protocols/ByteKernels.hpp"
 
 using namespace wm::protoc;
 
-std::vector<char> ShiftProtocol::encode(const Message &mes)
+size_t ShiftProtocol::encodeInto(const Message &mes, std::span<char> out)
 {
-    std::vector<char> shifted;
+    size_t size = mes.serializeInto(out);
 
-    shifted.reserve(mes.data.get().size());
+    char *payload = out.data() + MessageView::PREAMBLE_SIZE;
+    add_bytes(payload, payload, size - MessageView::PREAMBLE_SIZE, encodeDelta());
 
-    for (char byte : mes.data.get())
-    {
-        shifted.push_back(encodeByte(byte));
-    }
-
-    Message encodedMessage = mes;
-    encodedMessage.data = VectorChar(shifted);
-
-    auto serialized = encodedMessage.serialize();
-
-    return serialized;
-}
-
-char ShiftProtocol::encodeByte(const char byte)
-{
-    return static_cast<unsigned char>((byte + charShift) % 256);
-}
-
-char ShiftProtocol::decodeByte(const char byte)
-{
-    return static_cast<unsigned char>((byte - charShift + 256) % 256);
+    return size;
 }
 
 Message ShiftProtocol::decode(const char *data, size_t size)
 {
     Message mes = Message::deserialize(data, size);
 
-    std::vector<char> unshifted;
-    unshifted.reserve(mes.data.get().size());
+    add_bytes(mes.data.data(), mes.data.data(), mes.data.size(), decodeDelta());
 
-    for (char byte : mes.data.get())
-    {
-        unshifted.push_back(decodeByte(byte));
-    }
+    return mes;
+}
 
-    mes.data = VectorChar(unshifted);
+size_t ShiftProtocol::feed(std::span<const char> data, const MessageSink &on_message)
+{
+    MessageView encoded = MessageView::decode(data.data(), data.size());
 
-    return mes;
+    char payload[MessageView::MAX_SIZE];
+    add_bytes(encoded.data.data(), payload, encoded.data.size(), decodeDelta());
+
+    on_message(MessageView(encoded.len, encoded.idx, encoded.mesType, std::span<const char>(payload, encoded.data.size())));
+    return 1;
 }
@@ -0,0 +1,37 @@
+#include "protocols/SubstitutionProtocol.hpp"
+
+using namespace wm::protoc;
+
+SubstitutionProtocol::SubstitutionProtocol(const ByteTable &table) : m_encode(table), m_decode(invert_byte_table(table))
+{
+}
+
+size_t SubstitutionProtocol::encodeInto(const Message &mes, std::span<char> out)
+{
+    size_t size = mes.serializeInto(out);
+
+    char *payload = out.data() + MessageView::PREAMBLE_SIZE;
+    substitute_bytes(payload, payload, size - MessageView::PREAMBLE_SIZE, m_encode);
+
+    return size;
+}
+
+Message SubstitutionProtocol::decode(const char *data, size_t size)
+{
+    Message mes = Message::deserialize(data, size);
+
+    substitute_bytes(mes.data.data(), mes.data.data(), mes.data.size(), m_decode);
+
+    return mes;
+}
+
+size_t SubstitutionProtocol::feed(std::span<const char> data, const MessageSink &on_message)
+{
+    MessageView encoded = MessageView::decode(data.data(), data.size());
+
+    char payload[MessageView::MAX_SIZE];
+    substitute_bytes(encoded.data.data(), payload, encoded.data.size(), m_decode);
+
+    on_message(MessageView(encoded.len, encoded.idx, encoded.mesType, std::span<const char>(payload, encoded.data.size())));
+    return 1;
+}
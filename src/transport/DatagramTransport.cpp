@@ -0,0 +1,410 @@
+#include "transport/DatagramTransport.hpp"
+#include "transport/ThreadPolicy.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+
+using namespace wm::transport;
+
+namespace
+{
+	/// @brief Space reserved per datagram for the SCM_TIMESTAMPNS control message.
+	constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(struct timespec));
+
+	struct addrinfo *resolve(const std::string &host, uint16_t port, int family, int flags)
+	{
+		struct addrinfo hints{};
+		hints.ai_family = family;
+		hints.ai_socktype = SOCK_DGRAM;
+		hints.ai_flags = AI_NUMERICSERV | flags;
+
+		struct addrinfo *result = nullptr;
+		std::string service = std::to_string(port);
+		if (getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints, &result) != 0)
+		{
+			return nullptr;
+		}
+		return result;
+	}
+}
+
+DatagramTransport::DatagramTransport(const DatagramConfig &datagram_config, const SerialConfig &config)
+	: ITransport(config), m_datagram_config(datagram_config)
+{
+	m_datagram_config.batch_size = std::max<size_t>(m_datagram_config.batch_size, 1);
+	size_t batch = m_datagram_config.batch_size;
+
+	m_config.port = "udp://" + datagram_config.remote_host + ":" + std::to_string(datagram_config.remote_port);
+
+	m_rx_storage.resize(batch * (MAX_DATAGRAM_SIZE + 1));
+	m_rx_control.resize(batch * CONTROL_SIZE);
+	m_rx_iov.resize(batch);
+	m_rx_headers.resize(batch);
+	m_tx_iov.resize(batch);
+	m_tx_headers.resize(batch);
+
+	for (size_t i = 0; i < batch; ++i)
+	{
+		// One spare byte per slot so an oversized datagram shows up as longer than MAX_DATAGRAM_SIZE.
+		m_rx_iov[i].iov_base = m_rx_storage.data() + i * (MAX_DATAGRAM_SIZE + 1);
+		m_rx_iov[i].iov_len = MAX_DATAGRAM_SIZE + 1;
+		m_tx_headers[i].msg_hdr.msg_iov = &m_tx_iov[i];
+		m_tx_headers[i].msg_hdr.msg_iovlen = 1;
+	}
+}
+
+DatagramTransport::~DatagramTransport()
+{
+	close();
+}
+
+ErrorCode DatagramTransport::open()
+{
+	if (is_open())
+	{
+		return ErrorCode::PortAlreadyOpen;
+	}
+
+	if (m_config.lock_memory)
+	{
+		lock_process_memory();
+	}
+
+	auto status = openSocket();
+	if (status != ErrorCode::Success)
+	{
+		m_con_state = ConnectionState::Error;
+		return status;
+	}
+
+	m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_wake_fd < 0)
+	{
+		::close(m_fd);
+		m_fd = -1;
+		m_con_state = ConnectionState::Error;
+		return ErrorCode::OperationFailed;
+	}
+
+	m_con_state = ConnectionState::Open;
+	try
+	{
+		m_thread = std::thread(&DatagramTransport::receiveThread, this);
+	}
+	catch (const std::exception &ex)
+	{
+		std::cout << ex.what() << std::endl;
+		close();
+		m_con_state = ConnectionState::Error;
+		return ErrorCode::OperationFailed;
+	}
+	return ErrorCode::Success;
+}
+
+ErrorCode DatagramTransport::openSocket()
+{
+	struct addrinfo *local = resolve(m_datagram_config.local_host, m_datagram_config.local_port, AF_UNSPEC, AI_PASSIVE);
+	if (local == nullptr)
+	{
+		return ErrorCode::InvalidParameter;
+	}
+
+	m_fd = ::socket(local->ai_family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (m_fd < 0 || ::bind(m_fd, local->ai_addr, local->ai_addrlen) != 0)
+	{
+		std::cout << "Failed to bind datagram socket: " << strerror(errno) << std::endl;
+		freeaddrinfo(local);
+		if (m_fd >= 0)
+		{
+			::close(m_fd);
+			m_fd = -1;
+		}
+		return ErrorCode::PortNotFound;
+	}
+	int family = local->ai_family;
+	freeaddrinfo(local);
+
+	if (m_datagram_config.rcvbuf_size > 0)
+	{
+		setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &m_datagram_config.rcvbuf_size, sizeof(m_datagram_config.rcvbuf_size));
+	}
+	if (m_datagram_config.sndbuf_size > 0)
+	{
+		setsockopt(m_fd, SOL_SOCKET, SO_SNDBUF, &m_datagram_config.sndbuf_size, sizeof(m_datagram_config.sndbuf_size));
+	}
+	if (m_datagram_config.timestamps)
+	{
+		int enable = 1;
+		setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+	}
+
+	m_connected = false;
+	if (m_datagram_config.remote_port != 0)
+	{
+		struct addrinfo *remote = resolve(m_datagram_config.remote_host, m_datagram_config.remote_port, family, 0);
+		bool connected = remote != nullptr && ::connect(m_fd, remote->ai_addr, remote->ai_addrlen) == 0;
+		if (remote != nullptr)
+		{
+			freeaddrinfo(remote);
+		}
+		if (!connected)
+		{
+			::close(m_fd);
+			m_fd = -1;
+			return ErrorCode::PortNotFound;
+		}
+		m_connected = true;
+	}
+
+	return ErrorCode::Success;
+}
+
+ErrorCode DatagramTransport::close()
+{
+	if (m_fd < 0)
+	{
+		return ErrorCode::Success;
+	}
+
+	m_con_state = ConnectionState::Closed;
+
+	uint64_t signal = 1;
+	ssize_t written = ::write(m_wake_fd, &signal, sizeof(signal));
+	(void)written;
+
+	release_thread(m_thread);
+
+	::close(m_wake_fd);
+	m_wake_fd = -1;
+	::close(m_fd);
+	m_fd = -1;
+
+	return ErrorCode::Success;
+}
+
+int DatagramTransport::send(const char *data, size_t length)
+{
+	if (!is_open())
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+	if (!m_connected)
+	{
+		throw PortException("No remote endpoint configured", ErrorCode::InvalidParameter);
+	}
+	if (length > MAX_DATAGRAM_SIZE)
+	{
+		throw PortException("Frame exceeds maximum datagram size", ErrorCode::BufferOverflow);
+	}
+
+	ssize_t sent = ::send(m_fd, data, length, MSG_NOSIGNAL);
+	return sent < 0 ? -1 : static_cast<int>(sent);
+}
+
+int DatagramTransport::sendInPlace(size_t max_length, const FrameWriter &writer)
+{
+	if (max_length > MAX_DATAGRAM_SIZE)
+	{
+		return ITransport::sendInPlace(max_length, writer);
+	}
+
+	char frame[MAX_DATAGRAM_SIZE];
+	size_t length = writer(std::span<char>(frame, max_length));
+	return send(frame, length);
+}
+
+int DatagramTransport::sendBatch(std::span<const std::span<const char>> frames)
+{
+	if (!is_open())
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+	if (!m_connected)
+	{
+		throw PortException("No remote endpoint configured", ErrorCode::InvalidParameter);
+	}
+
+	// Checked before anything is sent so that a batch goes out whole or not at all.
+	for (const auto &frame : frames)
+	{
+		if (frame.size() > MAX_DATAGRAM_SIZE)
+		{
+			throw PortException("Frame exceeds maximum datagram size", ErrorCode::BufferOverflow);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(mtxTransmit);
+	size_t batch = m_datagram_config.batch_size;
+	size_t sent_total = 0;
+
+	while (sent_total < frames.size())
+	{
+		size_t count = std::min(batch, frames.size() - sent_total);
+		for (size_t i = 0; i < count; ++i)
+		{
+			const auto &frame = frames[sent_total + i];
+			m_tx_iov[i].iov_base = const_cast<char *>(frame.data());
+			m_tx_iov[i].iov_len = frame.size();
+		}
+
+		int sent = ::sendmmsg(m_fd, m_tx_headers.data(), static_cast<unsigned>(count), MSG_NOSIGNAL);
+		if (sent < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+			{
+				struct pollfd pfd{m_fd, POLLOUT, 0};
+				if (::poll(&pfd, 1, static_cast<int>(m_config.write_timeout_ms)) > 0)
+				{
+					continue;
+				}
+			}
+			break;
+		}
+		sent_total += static_cast<size_t>(sent);
+	}
+
+	return sent_total == 0 && !frames.empty() ? -1 : static_cast<int>(sent_total);
+}
+
+int DatagramTransport::receive(char *buffer, size_t length)
+{
+	ssize_t received = ::recv(m_fd, buffer, length, MSG_DONTWAIT);
+	if (received < 0)
+	{
+		return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+	}
+	return static_cast<int>(received);
+}
+
+int DatagramTransport::available() const
+{
+	int bytes = 0;
+	if (ioctl(m_fd, FIONREAD, &bytes) < 0)
+	{
+		return 0;
+	}
+	return bytes;
+}
+
+uint16_t DatagramTransport::localPort() const
+{
+	struct sockaddr_storage local{};
+	socklen_t length = sizeof(local);
+	if (m_fd < 0 || getsockname(m_fd, reinterpret_cast<struct sockaddr *>(&local), &length) != 0)
+	{
+		return 0;
+	}
+
+	if (local.ss_family == AF_INET6)
+	{
+		return ntohs(reinterpret_cast<struct sockaddr_in6 *>(&local)->sin6_port);
+	}
+	return ntohs(reinterpret_cast<struct sockaddr_in *>(&local)->sin_port);
+}
+
+void DatagramTransport::receiveThread()
+{
+	apply_thread_policy(m_config.rx_thread, "udp-rx");
+	struct pollfd fds[2] = {{m_fd, POLLIN, 0}, {m_wake_fd, POLLIN, 0}};
+
+	while (is_open())
+	{
+		int ready = ::poll(fds, 2, -1);
+		if (ready < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+		if (fds[1].revents != 0)
+		{
+			break;
+		}
+		if (fds[0].revents & (POLLERR | POLLNVAL))
+		{
+			// ICMP errors on a connected socket are reported here; reading clears them.
+			int error = 0;
+			socklen_t length = sizeof(error);
+			getsockopt(m_fd, SOL_SOCKET, SO_ERROR, &error, &length);
+		}
+		if ((fds[0].revents & POLLIN) && !drain())
+		{
+			std::cout << "Failed to read from socket, stopping receive thread" << std::endl;
+			m_con_state = ConnectionState::Error;
+			break;
+		}
+	}
+}
+
+bool DatagramTransport::drain()
+{
+	size_t batch = m_datagram_config.batch_size;
+
+	while (true)
+	{
+		for (size_t i = 0; i < batch; ++i)
+		{
+			auto &header = m_rx_headers[i].msg_hdr;
+			header = {};
+			header.msg_iov = &m_rx_iov[i];
+			header.msg_iovlen = 1;
+			if (m_datagram_config.timestamps)
+			{
+				header.msg_control = m_rx_control.data() + i * CONTROL_SIZE;
+				header.msg_controllen = CONTROL_SIZE;
+			}
+		}
+
+		int count = ::recvmmsg(m_fd, m_rx_headers.data(), static_cast<unsigned>(batch), MSG_DONTWAIT, nullptr);
+		if (count < 0)
+		{
+			// ECONNREFUSED is a stale ICMP error from an earlier send, not a broken socket.
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNREFUSED;
+		}
+		Timestamp received = monotonic_now();
+
+		for (int i = 0; i < count; ++i)
+		{
+			auto &header = m_rx_headers[i].msg_hdr;
+			size_t length = m_rx_headers[i].msg_len;
+
+			uint64_t kernel_time = 0;
+			for (auto *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+			{
+				if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+				{
+					struct timespec stamp;
+					std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+					kernel_time = static_cast<uint64_t>(stamp.tv_sec) * 1000000000ULL + static_cast<uint64_t>(stamp.tv_nsec);
+				}
+			}
+
+			try
+			{
+				decodeFrame(std::span<const char>(static_cast<const char *>(m_rx_iov[i].iov_base), length), received,
+							[this, kernel_time](const MessageView &mes)
+							{
+								MessageView stamped = mes;
+								stamped.kernel_rx_timestamp = kernel_time;
+								notifyReceive(stamped);
+							});
+			}
+			catch (const std::exception &)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (static_cast<size_t>(count) < batch)
+		{
+			return true;
+		}
+	}
+}
@@ -0,0 +1,191 @@
+#include "transport/IoUring.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <string>
+#include <vector>
+
+using namespace wm::transport;
+
+namespace
+{
+	int io_uring_setup(unsigned entries, struct io_uring_params *params)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+	}
+
+	int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+	}
+
+	int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args)
+	{
+		return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+	}
+}
+
+IoUring::IoUring(unsigned entries)
+{
+	struct io_uring_params params{};
+	m_ring_fd = io_uring_setup(entries, &params);
+	if (m_ring_fd < 0)
+	{
+		throw TransportException("io_uring_setup failed: " + std::string(strerror(errno)), ErrorCode::OperationFailed);
+	}
+
+	m_sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	m_cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single_mmap)
+	{
+		m_sq_map_size = std::max(m_sq_map_size, m_cq_map_size);
+	}
+
+	m_sq_map = ::mmap(nullptr, m_sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQ_RING);
+	if (m_sq_map == MAP_FAILED)
+	{
+		m_sq_map = nullptr;
+		release();
+		throw TransportException("Failed to map io_uring submission ring", ErrorCode::OperationFailed);
+	}
+
+	void *cq_base = m_sq_map;
+	if (!single_mmap)
+	{
+		m_cq_map = ::mmap(nullptr, m_cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_CQ_RING);
+		if (m_cq_map == MAP_FAILED)
+		{
+			m_cq_map = nullptr;
+			release();
+			throw TransportException("Failed to map io_uring completion ring", ErrorCode::OperationFailed);
+		}
+		cq_base = m_cq_map;
+	}
+
+	m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+	void *sqes = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED)
+	{
+		release();
+		throw TransportException("Failed to map io_uring submission entries", ErrorCode::OperationFailed);
+	}
+	m_sqes = static_cast<struct io_uring_sqe *>(sqes);
+
+	auto *sq = static_cast<char *>(m_sq_map);
+	m_sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+	m_sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+	m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+	m_sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+	m_sq_entries = params.sq_entries;
+	m_sqe_tail = *m_sq_tail;
+
+	auto *cq = static_cast<char *>(cq_base);
+	m_cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+	m_cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+	m_cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+	m_cqes = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+}
+
+IoUring::~IoUring()
+{
+	release();
+}
+
+void IoUring::release()
+{
+	if (m_sqes != nullptr)
+	{
+		::munmap(m_sqes, m_sqes_size);
+		m_sqes = nullptr;
+	}
+	if (m_cq_map != nullptr)
+	{
+		::munmap(m_cq_map, m_cq_map_size);
+		m_cq_map = nullptr;
+	}
+	if (m_sq_map != nullptr)
+	{
+		::munmap(m_sq_map, m_sq_map_size);
+		m_sq_map = nullptr;
+	}
+	if (m_ring_fd >= 0)
+	{
+		::close(m_ring_fd);
+		m_ring_fd = -1;
+	}
+}
+
+bool IoUring::isSupported()
+{
+	static const bool supported = []
+	{
+		try
+		{
+			IoUring ring(2);
+
+			constexpr unsigned probe_ops = IORING_OP_LAST;
+			std::vector<char> storage(sizeof(struct io_uring_probe) + probe_ops * sizeof(struct io_uring_probe_op));
+			auto *probe = reinterpret_cast<struct io_uring_probe *>(storage.data());
+			if (io_uring_register(ring.m_ring_fd, IORING_REGISTER_PROBE, probe, probe_ops) < 0)
+			{
+				return false;
+			}
+
+			for (auto op : {IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_WRITEV, IORING_OP_POLL_ADD, IORING_OP_TIMEOUT, IORING_OP_LINK_TIMEOUT, IORING_OP_ASYNC_CANCEL})
+			{
+				if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+		catch (const TransportException &)
+		{
+			return false;
+		}
+	}();
+	return supported;
+}
+
+struct io_uring_sqe *IoUring::getSqe()
+{
+	unsigned head = std::atomic_ref<unsigned>(*m_sq_head).load(std::memory_order_acquire);
+	if (m_sqe_tail - head >= m_sq_entries)
+	{
+		return nullptr;
+	}
+
+	unsigned index = m_sqe_tail & m_sq_mask;
+	m_sq_array[index] = index;
+	++m_sqe_tail;
+
+	struct io_uring_sqe *sqe = &m_sqes[index];
+	std::memset(sqe, 0, sizeof(*sqe));
+	return sqe;
+}
+
+int IoUring::submitAndWait(unsigned wait_count)
+{
+	std::atomic_ref<unsigned>(*m_sq_tail).store(m_sqe_tail, std::memory_order_release);
+	unsigned to_submit = m_sqe_tail - std::atomic_ref<unsigned>(*m_sq_head).load(std::memory_order_acquire);
+
+	if (to_submit == 0 && wait_count == 0)
+	{
+		return 0;
+	}
+
+	int result = io_uring_enter(m_ring_fd, to_submit, wait_count, wait_count > 0 ? IORING_ENTER_GETEVENTS : 0);
+	return result < 0 ? -errno : result;
+}
+
+ErrorCode IoUring::registerBuffers(const struct iovec *buffers, unsigned count)
+{
+	if (io_uring_register(m_ring_fd, IORING_REGISTER_BUFFERS, buffers, count) < 0)
+	{
+		return ErrorCode::OperationFailed;
+	}
+	return ErrorCode::Success;
+}
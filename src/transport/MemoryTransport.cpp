@@ -0,0 +1,208 @@
+#include "transport/MemoryTransport.hpp"
+#include "transport/ThreadPolicy.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace wm::transport;
+
+MemoryTransport::Pair MemoryTransport::createPair(const SerialConfig &config, Delivery delivery)
+{
+	auto a_to_b = std::make_shared<Channel>(config.rx_buffer_size);
+	auto b_to_a = std::make_shared<Channel>(config.rx_buffer_size);
+
+	return Pair(std::unique_ptr<MemoryTransport>(new MemoryTransport(config, delivery, b_to_a, a_to_b)),
+				std::unique_ptr<MemoryTransport>(new MemoryTransport(config, delivery, a_to_b, b_to_a)));
+}
+
+MemoryTransport::MemoryTransport(const SerialConfig &config, Delivery delivery, std::shared_ptr<Channel> rx, std::shared_ptr<Channel> tx)
+	: ITransport(config),
+	  m_delivery(delivery),
+	  m_rx(std::move(rx)),
+	  m_tx(std::move(tx)),
+	  m_rx_ring(std::max<size_t>(config.rx_buffer_size, 2 * Framer::MAX_FRAME_SIZE)),
+	  m_framer(config.framing)
+{
+}
+
+MemoryTransport::~MemoryTransport()
+{
+	close();
+}
+
+ErrorCode MemoryTransport::open()
+{
+	if (is_open())
+	{
+		return ErrorCode::PortAlreadyOpen;
+	}
+
+	char discard[256];
+	while (m_rx->popBatch(discard, sizeof(discard)) > 0)
+	{
+	}
+	m_rx_ring.clear();
+
+	m_con_state = ConnectionState::Open;
+
+	if (m_delivery == Delivery::Thread)
+	{
+		m_stop.store(false, std::memory_order_release);
+		try
+		{
+			m_thread = std::thread(&MemoryTransport::receiveThread, this);
+		}
+		catch (const std::exception &ex)
+		{
+			std::cout << ex.what() << std::endl;
+			m_con_state = ConnectionState::Error;
+			return ErrorCode::OperationFailed;
+		}
+	}
+	return ErrorCode::Success;
+}
+
+ErrorCode MemoryTransport::close()
+{
+	if (m_con_state == ConnectionState::Closed)
+	{
+		return ErrorCode::Success;
+	}
+
+	m_con_state = ConnectionState::Closed;
+	m_stop.store(true, std::memory_order_release);
+	m_rx->wake();
+
+	release_thread(m_thread);
+	return ErrorCode::Success;
+}
+
+int MemoryTransport::send(const char *data, size_t length)
+{
+	if (!is_open())
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+
+	if (data == nullptr || length == 0)
+	{
+		return 0;
+	}
+
+	if (!m_framer.accepts(length))
+	{
+		throw PortException("Frame too long for the framing mode", ErrorCode::InvalidParameter);
+	}
+
+	std::lock_guard<std::mutex> lock(mtxTransmit);
+	m_framer.writeFrame(data, length, [this](const char *bytes, size_t count)
+						{ pushAll(bytes, count); });
+	return static_cast<int>(length);
+}
+
+int MemoryTransport::sendInPlace(size_t max_length, const FrameWriter &writer)
+{
+	if (!m_framer.accepts(max_length) || m_framer.maxWireSize(max_length) > sizeof(m_staging))
+	{
+		return ITransport::sendInPlace(max_length, writer);
+	}
+
+	if (!is_open())
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+
+	std::lock_guard<std::mutex> lock(mtxTransmit);
+	size_t length = writer(std::span<char>(m_staging + m_framer.headerSize(), max_length));
+	if (length > 0)
+	{
+		pushAll(m_staging, m_framer.finish(m_staging, length));
+	}
+	return static_cast<int>(length);
+}
+
+void MemoryTransport::pushAll(const char *data, size_t length)
+{
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_config.write_timeout_ms);
+	size_t pushed = m_tx->tryPushBatch(data, length);
+
+	while (pushed < length)
+	{
+		m_tx->notifyConsumer();
+		if (std::chrono::steady_clock::now() > deadline)
+		{
+			throw TimeoutException("Peer receive ring full");
+		}
+		std::this_thread::yield();
+		pushed += m_tx->tryPushBatch(data + pushed, length - pushed);
+	}
+
+	m_tx->notifyConsumer();
+}
+
+int MemoryTransport::receive(char *buffer, size_t length)
+{
+	if (m_delivery != Delivery::Manual)
+	{
+		return -1;
+	}
+	return static_cast<int>(m_rx->popBatch(buffer, length));
+}
+
+int MemoryTransport::available() const
+{
+	return static_cast<int>(m_rx->size());
+}
+
+size_t MemoryTransport::poll()
+{
+	if (m_delivery != Delivery::Manual || !is_open())
+	{
+		return 0;
+	}
+	return drain();
+}
+
+void MemoryTransport::receiveThread()
+{
+	apply_thread_policy(m_config.rx_thread, "mem-rx");
+	while (!m_stop.load(std::memory_order_acquire))
+	{
+		if (m_rx->waitForData(std::chrono::milliseconds(100)))
+		{
+			drain();
+		}
+	}
+}
+
+size_t MemoryTransport::drain()
+{
+	size_t frames = 0;
+
+	while (true)
+	{
+		// The framer leaves at most one partial frame behind, so the tail segment is never empty.
+		auto segment = m_rx_ring.writable()[0];
+		size_t count = m_rx->popBatch(segment.data(), segment.size());
+		if (count == 0)
+		{
+			break;
+		}
+		m_rx_ring.commit(count);
+		Timestamp received = monotonic_now();
+
+		frames += m_framer.extract(m_rx_ring, [this, received](const char *frame, size_t length)
+								   {
+			try
+			{
+				decodeFrame(std::span<const char>(frame, length), received, [this](const MessageView &mes)
+							{ notifyReceive(mes); });
+			}
+			catch (const std::exception &ex)
+			{
+				std::cout << "Exception: " << ex.what() << std::endl;
+			} });
+	}
+
+	return frames;
+}
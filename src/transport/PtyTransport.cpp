@@ -0,0 +1,31 @@
+#include "transport/PtyTransport.hpp"
+#include <climits>
+#include <pty.h>
+
+using namespace wm::transport;
+
+PtyTransport::PtyTransport(const SerialConfig &config) : UartTransport(config)
+{
+	char name[PATH_MAX] = {0};
+	if (openpty(&m_master_fd, &m_slave_fd, name, nullptr, nullptr) != 0)
+	{
+		throw PortException("Failed to allocate a pseudo-terminal", ErrorCode::PortNotFound);
+	}
+
+	struct termios options;
+	if (tcgetattr(m_master_fd, &options) == 0)
+	{
+		cfmakeraw(&options);
+		tcsetattr(m_master_fd, TCSANOW, &options);
+	}
+
+	m_config.port = name;
+}
+
+PtyTransport::~PtyTransport()
+{
+	// Closed before the pty goes away so the receive thread does not see a hangup.
+	close();
+	::close(m_slave_fd);
+	::close(m_master_fd);
+}
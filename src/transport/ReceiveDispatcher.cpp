@@ -0,0 +1,429 @@
+#include "transport/ReceiveDispatcher.hpp"
+#include "transport/ThreadPolicy.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace wm::transport;
+using namespace wm::messages;
+
+namespace
+{
+	/// @brief Raises a counter to value if it is lower.
+	template <typename T>
+	void raise_to(std::atomic<T> &counter, T value)
+	{
+		T current = counter.load(std::memory_order_relaxed);
+		while (current < value && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	/// @brief Stops a Serial executor thread, detaching it when called from that thread.
+	template <typename S>
+	void stop_serial_thread(S &subscriber)
+	{
+		if (!subscriber.thread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(subscriber.mtx);
+			subscriber.stop = true;
+		}
+		subscriber.cv.notify_one();
+
+		if (subscriber.thread.get_id() == std::this_thread::get_id())
+		{
+			subscriber.thread.detach();
+		}
+		else
+		{
+			subscriber.thread.join();
+		}
+	}
+}
+
+ReceiveSubscription &ReceiveSubscription::operator=(ReceiveSubscription &&other) noexcept
+{
+	if (this != &other)
+	{
+		unsubscribe();
+		m_link = std::move(other.m_link);
+		m_id = other.m_id;
+		other.m_id = 0;
+	}
+	return *this;
+}
+
+void ReceiveSubscription::unsubscribe()
+{
+	if (m_id == 0)
+	{
+		return;
+	}
+
+	ReceiveDispatcher *dispatcher = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_link->mutex);
+		dispatcher = m_link->dispatcher;
+		if (dispatcher != nullptr)
+		{
+			++m_link->users;
+		}
+	}
+
+	// Unlocked, so a Serial thread joined by this call can still unsubscribe its own handles.
+	if (dispatcher != nullptr)
+	{
+		dispatcher->unsubscribe(m_id);
+
+		std::lock_guard<std::mutex> lock(m_link->mutex);
+		if (--m_link->users == 0)
+		{
+			m_link->idle.notify_all();
+		}
+	}
+	m_link.reset();
+	m_id = 0;
+}
+
+ReceiveDispatcher::ReceiveDispatcher(size_t pool_size, const ThreadPolicy &thread_policy)
+	: m_link(std::make_shared<DispatcherLink>()),
+	  m_pool_size(std::max<size_t>(pool_size, 1)),
+	  m_thread_policy(thread_policy)
+{
+	m_link->dispatcher = this;
+
+	std::lock_guard<std::mutex> lock(m_update_mtx);
+	publish({});
+}
+
+ReceiveDispatcher::~ReceiveDispatcher()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_link->mutex);
+		m_link->dispatcher = nullptr;
+		m_link->idle.wait(lock, [this]
+						  { return m_link->users == 0; });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_pool_mtx);
+		m_pool_stop = true;
+	}
+	m_pool_cv.notify_all();
+	for (auto &worker : m_pool)
+	{
+		worker.join();
+	}
+
+	for (auto &subscriber : m_current->subscribers)
+	{
+		stop_serial_thread(*subscriber);
+	}
+}
+
+ReceiveSubscription ReceiveDispatcher::subscribe(Callback callback, const SubscribeOptions &options)
+{
+	auto subscriber = std::make_shared<Subscriber>();
+	subscriber->callback = std::move(callback);
+	subscriber->options = options;
+
+	if (options.mode == DispatchMode::Serial)
+	{
+		subscriber->thread = std::thread(&ReceiveDispatcher::serialThread, this, subscriber);
+	}
+	else if (options.mode == DispatchMode::Pool)
+	{
+		std::lock_guard<std::mutex> lock(m_pool_mtx);
+		startPool();
+	}
+
+	std::lock_guard<std::mutex> lock(m_update_mtx);
+	subscriber->id = m_next_id++;
+
+	auto subscribers = m_current->subscribers;
+	subscribers.push_back(subscriber);
+	publish(std::move(subscribers));
+
+	return ReceiveSubscription(m_link, subscriber->id);
+}
+
+void ReceiveDispatcher::unsubscribe(uint64_t id)
+{
+	std::shared_ptr<Subscriber> removed;
+	{
+		std::lock_guard<std::mutex> lock(m_update_mtx);
+
+		auto subscribers = m_current->subscribers;
+		auto it = std::find_if(subscribers.begin(), subscribers.end(), [id](const auto &subscriber)
+							   { return subscriber->id == id; });
+		if (it == subscribers.end())
+		{
+			return;
+		}
+
+		removed = *it;
+		removed->active.store(false, std::memory_order_relaxed);
+		subscribers.erase(it);
+		publish(std::move(subscribers));
+	}
+
+	stop_serial_thread(*removed);
+}
+
+void ReceiveDispatcher::publish(std::vector<std::shared_ptr<Subscriber>> subscribers)
+{
+	auto routes = std::make_unique<Routes>();
+	routes->subscribers = std::move(subscribers);
+
+	// Counting sort into one flat array: subscribers for every type, in subscription order.
+	for (const auto &subscriber : routes->subscribers)
+	{
+		if (subscriber->options.type)
+		{
+			++routes->offsets[static_cast<uint8_t>(*subscriber->options.type) + 1];
+		}
+		else
+		{
+			for (size_t type = 0; type < TYPE_SLOTS; ++type)
+			{
+				++routes->offsets[type + 1];
+			}
+		}
+	}
+	for (size_t type = 0; type < TYPE_SLOTS; ++type)
+	{
+		routes->offsets[type + 1] += routes->offsets[type];
+	}
+
+	routes->targets.resize(routes->offsets[TYPE_SLOTS]);
+	auto next = routes->offsets;
+	for (const auto &subscriber : routes->subscribers)
+	{
+		if (subscriber->options.type)
+		{
+			routes->targets[next[static_cast<uint8_t>(*subscriber->options.type)]++] = subscriber.get();
+		}
+		else
+		{
+			for (size_t type = 0; type < TYPE_SLOTS; ++type)
+			{
+				routes->targets[next[type]++] = subscriber.get();
+			}
+		}
+	}
+
+	if (m_current != nullptr)
+	{
+		m_retired.push_back(std::move(m_current));
+	}
+	m_current = std::move(routes);
+	m_routes.store(m_current.get(), std::memory_order_seq_cst);
+
+	// A dispatch() that starts after the store sees the new table, so with no reader
+	// in progress none of the retired ones can still be in use.
+	if (m_readers.load(std::memory_order_seq_cst) == 0)
+	{
+		m_retired.clear();
+	}
+}
+
+void ReceiveDispatcher::dispatch(const MessageView &message)
+{
+	struct ReadGuard
+	{
+		std::atomic<uint32_t> &readers;
+		~ReadGuard() { readers.fetch_sub(1, std::memory_order_release); }
+	};
+
+	m_readers.fetch_add(1, std::memory_order_seq_cst);
+	ReadGuard guard{m_readers};
+	const Routes *routes = m_routes.load(std::memory_order_seq_cst);
+
+	auto type = static_cast<uint8_t>(message.mesType);
+	for (uint32_t i = routes->offsets[type]; i < routes->offsets[type + 1]; ++i)
+	{
+		Subscriber &subscriber = *routes->targets[i];
+		if (!subscriber.matches(message))
+		{
+			continue;
+		}
+
+		switch (subscriber.options.mode)
+		{
+		case DispatchMode::Inline:
+			invoke(subscriber, message);
+			break;
+
+		case DispatchMode::Pool:
+			if (reserveSlot(subscriber))
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_pool_mtx);
+					m_pool_queue.emplace_back(subscriber.shared_from_this(), message.toOwned());
+				}
+				m_pool_cv.notify_one();
+			}
+			break;
+
+		case DispatchMode::Serial:
+			if (reserveSlot(subscriber))
+			{
+				{
+					std::lock_guard<std::mutex> lock(subscriber.mtx);
+					subscriber.queue.push_back(message.toOwned());
+				}
+				subscriber.cv.notify_one();
+			}
+			break;
+		}
+	}
+}
+
+std::vector<SubscriberStats> ReceiveDispatcher::stats() const
+{
+	std::lock_guard<std::mutex> lock(m_update_mtx);
+
+	std::vector<SubscriberStats> result;
+	result.reserve(m_current->subscribers.size());
+
+	for (const auto &subscriber : m_current->subscribers)
+	{
+		SubscriberStats stats;
+		stats.name = subscriber->options.name;
+		stats.mode = subscriber->options.mode;
+		stats.delivered = subscriber->delivered.load(std::memory_order_relaxed);
+		stats.dropped = subscriber->dropped.load(std::memory_order_relaxed);
+		stats.queue_depth = subscriber->queue_depth.load(std::memory_order_relaxed);
+		stats.max_queue_depth = subscriber->max_queue_depth.load(std::memory_order_relaxed);
+		stats.handler_ns_total = subscriber->handler_ns_total.load(std::memory_order_relaxed);
+		stats.handler_ns_max = subscriber->handler_ns_max.load(std::memory_order_relaxed);
+		result.push_back(std::move(stats));
+	}
+	return result;
+}
+
+bool ReceiveDispatcher::Subscriber::matches(const MessageView &message) const
+{
+	if (message.idx < options.idx_min || message.idx > options.idx_max)
+	{
+		return false;
+	}
+
+	const auto &prefix = options.payload_prefix;
+	return prefix.empty() ||
+		   (message.data.size() >= prefix.size() && std::memcmp(message.data.data(), prefix.data(), prefix.size()) == 0);
+}
+
+bool ReceiveDispatcher::reserveSlot(Subscriber &subscriber)
+{
+	size_t depth = subscriber.queue_depth.load(std::memory_order_relaxed);
+	do
+	{
+		if (depth >= subscriber.options.queue_limit)
+		{
+			subscriber.dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	} while (!subscriber.queue_depth.compare_exchange_weak(depth, depth + 1, std::memory_order_relaxed));
+
+	raise_to(subscriber.max_queue_depth, depth + 1);
+	return true;
+}
+
+void ReceiveDispatcher::invoke(Subscriber &subscriber, const MessageView &message)
+{
+	if (!subscriber.active.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	Timestamp start = monotonic_now();
+	subscriber.callback(message);
+	uint64_t elapsed = monotonic_now() - start;
+
+	subscriber.handler_ns_total.fetch_add(elapsed, std::memory_order_relaxed);
+	raise_to(subscriber.handler_ns_max, elapsed);
+	subscriber.delivered.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReceiveDispatcher::invokeQueued(Subscriber &subscriber, const Message &message)
+{
+	try
+	{
+		invoke(subscriber, message.view());
+	}
+	catch (const std::exception &ex)
+	{
+		std::cout << "Exception in receive callback " << subscriber.options.name << ": " << ex.what() << std::endl;
+	}
+	subscriber.queue_depth.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ReceiveDispatcher::serialThread(std::shared_ptr<Subscriber> subscriber)
+{
+	ThreadPolicy policy = m_thread_policy;
+	if (!subscriber->options.name.empty())
+	{
+		policy.name = subscriber->options.name;
+	}
+	apply_thread_policy(policy, "rx-serial");
+
+	std::unique_lock<std::mutex> lock(subscriber->mtx);
+	while (true)
+	{
+		subscriber->cv.wait(lock, [&subscriber]
+							{ return !subscriber->queue.empty() || subscriber->stop; });
+		if (subscriber->stop)
+		{
+			break;
+		}
+
+		Message message = subscriber->queue.front();
+		subscriber->queue.pop_front();
+
+		lock.unlock();
+		invokeQueued(*subscriber, message);
+		lock.lock();
+	}
+}
+
+void ReceiveDispatcher::poolThread()
+{
+	apply_thread_policy(m_thread_policy, "rx-pool");
+
+	std::unique_lock<std::mutex> lock(m_pool_mtx);
+	while (true)
+	{
+		m_pool_cv.wait(lock, [this]
+					   { return !m_pool_queue.empty() || m_pool_stop; });
+		if (m_pool_stop)
+		{
+			break;
+		}
+
+		auto [subscriber, message] = std::move(m_pool_queue.front());
+		m_pool_queue.pop_front();
+
+		lock.unlock();
+		invokeQueued(*subscriber, message);
+		subscriber.reset();
+		lock.lock();
+	}
+}
+
+void ReceiveDispatcher::startPool()
+{
+	if (!m_pool.empty())
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_pool_size; ++i)
+	{
+		m_pool.emplace_back(&ReceiveDispatcher::poolThread, this);
+	}
+}
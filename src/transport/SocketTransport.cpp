@@ -0,0 +1,204 @@
+#include "transport/SocketTransport.hpp"
+#include <cstring>
+#include <iostream>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace wm::transport;
+
+namespace
+{
+	PortName describeEndpoint(const SocketConfig &config)
+	{
+		if (config.family == SocketFamily::Unix)
+		{
+			return "unix:" + config.path;
+		}
+		return "tcp://" + config.host + ":" + std::to_string(config.port);
+	}
+}
+
+SocketTransport::SocketTransport(const SocketConfig &socket_config, const SerialConfig &config)
+	: UartTransport(config), m_socket_config(socket_config)
+{
+	m_config.port = describeEndpoint(socket_config);
+}
+
+SocketTransport::SocketTransport(int connected_fd, const SocketConfig &socket_config, const SerialConfig &config)
+	: UartTransport(config), m_socket_config(socket_config), m_adopted_fd(connected_fd)
+{
+	m_config.port = "fd:" + std::to_string(connected_fd);
+}
+
+SocketTransport::~SocketTransport()
+{
+	close();
+	if (m_adopted_fd >= 0)
+	{
+		::close(m_adopted_fd);
+	}
+}
+
+ErrorCode SocketTransport::openDescriptor()
+{
+	if (m_adopted_fd >= 0)
+	{
+		m_fd = m_adopted_fd;
+		m_adopted_fd = -1;
+	}
+	else
+	{
+		std::cout << "Connecting to: " << m_config.port << std::endl;
+		auto status = connectSocket();
+		if (status != ErrorCode::Success)
+		{
+			return status;
+		}
+	}
+
+	auto status = configureSocket();
+	if (status != ErrorCode::Success)
+	{
+		::close(m_fd);
+		m_fd = -1;
+	}
+	return status;
+}
+
+ErrorCode SocketTransport::connectSocket()
+{
+	if (m_socket_config.family == SocketFamily::Unix)
+	{
+		struct sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (m_socket_config.path.empty() || m_socket_config.path.size() >= sizeof(address.sun_path))
+		{
+			return ErrorCode::InvalidParameter;
+		}
+		std::memcpy(address.sun_path, m_socket_config.path.c_str(), m_socket_config.path.size() + 1);
+
+		int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (fd < 0)
+		{
+			return ErrorCode::OperationFailed;
+		}
+
+		auto status = connectWithTimeout(fd, reinterpret_cast<const struct sockaddr *>(&address), sizeof(address));
+		if (status != ErrorCode::Success)
+		{
+			::close(fd);
+			return status;
+		}
+		m_fd = fd;
+		return ErrorCode::Success;
+	}
+
+	struct addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_NUMERICSERV;
+
+	struct addrinfo *addresses = nullptr;
+	std::string service = std::to_string(m_socket_config.port);
+	if (getaddrinfo(m_socket_config.host.c_str(), service.c_str(), &hints, &addresses) != 0)
+	{
+		return ErrorCode::PortNotFound;
+	}
+
+	auto status = ErrorCode::PortNotFound;
+	for (auto *candidate = addresses; candidate != nullptr; candidate = candidate->ai_next)
+	{
+		int fd = ::socket(candidate->ai_family, candidate->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, candidate->ai_protocol);
+		if (fd < 0)
+		{
+			continue;
+		}
+
+		status = connectWithTimeout(fd, candidate->ai_addr, candidate->ai_addrlen);
+		if (status == ErrorCode::Success)
+		{
+			m_fd = fd;
+			break;
+		}
+		::close(fd);
+	}
+
+	freeaddrinfo(addresses);
+	return status;
+}
+
+ErrorCode SocketTransport::connectWithTimeout(int fd, const struct sockaddr *address, socklen_t length)
+{
+	if (::connect(fd, address, length) == 0)
+	{
+		return ErrorCode::Success;
+	}
+	if (errno != EINPROGRESS && errno != EAGAIN)
+	{
+		return ErrorCode::PortNotFound;
+	}
+
+	struct pollfd pfd{fd, POLLOUT, 0};
+	int ready;
+	do
+	{
+		ready = ::poll(&pfd, 1, static_cast<int>(m_socket_config.connect_timeout_ms));
+	} while (ready < 0 && errno == EINTR);
+
+	if (ready == 0)
+	{
+		return ErrorCode::OperationTimeout;
+	}
+
+	int error = 0;
+	socklen_t error_length = sizeof(error);
+	if (ready < 0 || getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_length) != 0 || error != 0)
+	{
+		return ErrorCode::PortNotFound;
+	}
+	return ErrorCode::Success;
+}
+
+ErrorCode SocketTransport::configureSocket()
+{
+	struct sockaddr_storage local{};
+	socklen_t local_length = sizeof(local);
+	if (getsockname(m_fd, reinterpret_cast<struct sockaddr *>(&local), &local_length) != 0)
+	{
+		return ErrorCode::InvalidParameter;
+	}
+
+	bool is_tcp = local.ss_family == AF_INET || local.ss_family == AF_INET6;
+	if (is_tcp && m_socket_config.no_delay)
+	{
+		int enable = 1;
+		setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+	}
+	if (m_socket_config.rcvbuf_size > 0)
+	{
+		setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &m_socket_config.rcvbuf_size, sizeof(m_socket_config.rcvbuf_size));
+	}
+	if (m_socket_config.sndbuf_size > 0)
+	{
+		setsockopt(m_fd, SOL_SOCKET, SO_SNDBUF, &m_socket_config.sndbuf_size, sizeof(m_socket_config.sndbuf_size));
+	}
+
+	int flags = fcntl(m_fd, F_GETFL);
+	if (flags < 0 || fcntl(m_fd, F_SETFL, flags | O_NONBLOCK) != 0)
+	{
+		return ErrorCode::OperationFailed;
+	}
+	return ErrorCode::Success;
+}
+
+ssize_t SocketTransport::writeSegments(const struct iovec *iov, int iov_count)
+{
+	struct msghdr message{};
+	message.msg_iov = const_cast<struct iovec *>(iov);
+	message.msg_iovlen = static_cast<size_t>(iov_count);
+	return ::sendmsg(m_fd, &message, MSG_NOSIGNAL);
+}
@@ -0,0 +1,33 @@
+#include "transport/Termios2.hpp"
+
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+namespace wm::transport
+{
+    bool set_custom_baudrate(int fd, uint32_t rate)
+    {
+        struct termios2 options;
+        if (ioctl(fd, TCGETS2, &options) != 0)
+        {
+            return false;
+        }
+
+        options.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+        options.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+        options.c_ispeed = rate;
+        options.c_ospeed = rate;
+
+        return ioctl(fd, TCSETS2, &options) == 0;
+    }
+
+    uint32_t get_actual_baudrate(int fd)
+    {
+        struct termios2 options;
+        if (ioctl(fd, TCGETS2, &options) != 0)
+        {
+            return 0;
+        }
+        return options.c_ospeed;
+    }
+}
@@ -0,0 +1,96 @@
+#include "transport/ThreadPolicy.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+namespace wm::transport
+{
+    ErrorCode apply_thread_policy(const ThreadPolicy &policy, const char *default_name)
+    {
+        auto status = ErrorCode::Success;
+        pthread_t self = pthread_self();
+
+        // Linux limits thread names to 15 characters plus the terminator.
+        std::string name = policy.name.empty() ? default_name : policy.name;
+        name.resize(std::min<size_t>(name.size(), 15));
+        pthread_setname_np(self, name.c_str());
+
+        if (!policy.cpus.empty())
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (int cpu : policy.cpus)
+            {
+                if (cpu < 0 || cpu >= CPU_SETSIZE)
+                {
+                    std::cout << "Invalid CPU " << cpu << " for thread " << name << std::endl;
+                    return ErrorCode::InvalidParameter;
+                }
+                CPU_SET(cpu, &cpus);
+            }
+
+            int error = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+            if (error != 0)
+            {
+                std::cout << "Failed to set CPU affinity for thread " << name << ": " << strerror(error) << std::endl;
+                status = ErrorCode::OperationFailed;
+            }
+        }
+
+        if (policy.policy != SchedPolicy::Default)
+        {
+            int sched_policy = policy.policy == SchedPolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+            if (policy.priority < sched_get_priority_min(sched_policy) || policy.priority > sched_get_priority_max(sched_policy))
+            {
+                std::cout << "Invalid real-time priority " << policy.priority << " for thread " << name << std::endl;
+                return ErrorCode::InvalidParameter;
+            }
+
+            struct sched_param param{};
+            param.sched_priority = policy.priority;
+            int error = pthread_setschedparam(self, sched_policy, &param);
+            if (error != 0)
+            {
+                std::cout << "Failed to set real-time priority " << policy.priority << " for thread " << name << ": "
+                          << strerror(error) << (error == EPERM ? " (needs CAP_SYS_NICE or an rtprio limit)" : "") << std::endl;
+                status = ErrorCode::OperationFailed;
+            }
+        }
+
+        return status;
+    }
+
+    ErrorCode lock_process_memory()
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            int error = errno;
+            std::cout << "Failed to lock memory: " << strerror(error)
+                      << (error == EPERM || error == ENOMEM ? " (needs CAP_IPC_LOCK or a higher memlock limit)" : "") << std::endl;
+            return ErrorCode::OperationFailed;
+        }
+        return ErrorCode::Success;
+    }
+
+    void release_thread(std::thread &thread)
+    {
+        if (!thread.joinable())
+        {
+            return;
+        }
+
+        if (thread.get_id() == std::this_thread::get_id())
+        {
+            thread.detach();
+        }
+        else
+        {
+            thread.join();
+        }
+    }
+}
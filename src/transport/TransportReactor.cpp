@@ -0,0 +1,213 @@
+#include "transport/TransportReactor.hpp"
+#include <algorithm>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+using namespace wm::transport;
+
+namespace
+{
+	/// @brief Source whose handler the calling reactor thread is running, if any.
+	thread_local IPollable *t_dispatching = nullptr;
+}
+
+TransportReactor::TransportReactor(size_t thread_count)
+	: m_thread_count(std::max<size_t>(thread_count, 1)),
+	  m_oneshot(thread_count > 1)
+{
+	m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_epoll_fd < 0 || m_wake_fd < 0)
+	{
+		if (m_epoll_fd >= 0)
+			::close(m_epoll_fd);
+		if (m_wake_fd >= 0)
+			::close(m_wake_fd);
+		throw TransportException("Failed to create reactor epoll set", ErrorCode::OperationFailed);
+	}
+
+	struct epoll_event wake_event{};
+	wake_event.events = EPOLLIN;
+	wake_event.data.ptr = nullptr;
+	epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wake_fd, &wake_event);
+}
+
+TransportReactor::~TransportReactor()
+{
+	stop();
+	::close(m_wake_fd);
+	::close(m_epoll_fd);
+}
+
+void TransportReactor::start()
+{
+	if (m_running.exchange(true))
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < m_thread_count; ++i)
+	{
+		m_threads.emplace_back(&TransportReactor::run, this);
+	}
+}
+
+void TransportReactor::stop()
+{
+	if (!m_running.exchange(false))
+	{
+		return;
+	}
+
+	// The eventfd stays readable until drained, so every thread in the pool sees it.
+	uint64_t signal = 1;
+	ssize_t written = ::write(m_wake_fd, &signal, sizeof(signal));
+	(void)written;
+
+	for (auto &thread : m_threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	m_threads.clear();
+
+	ssize_t drained = ::read(m_wake_fd, &signal, sizeof(signal));
+	(void)drained;
+}
+
+ErrorCode TransportReactor::add(IPollable *source)
+{
+	if (source == nullptr || source->pollFd() < 0)
+	{
+		return ErrorCode::InvalidParameter;
+	}
+
+	std::lock_guard<std::mutex> lock(m_sources_mutex);
+	if (!m_sources.emplace(source, 0).second)
+	{
+		return ErrorCode::PortAlreadyOpen;
+	}
+
+	struct epoll_event event{};
+	event.events = m_oneshot ? (EPOLLIN | EPOLLONESHOT) : EPOLLIN;
+	event.data.ptr = source;
+	if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, source->pollFd(), &event) != 0)
+	{
+		m_sources.erase(source);
+		return ErrorCode::OperationFailed;
+	}
+
+	return ErrorCode::Success;
+}
+
+ErrorCode TransportReactor::remove(IPollable *source)
+{
+	std::unique_lock<std::mutex> lock(m_sources_mutex);
+	if (!m_sources.contains(source))
+	{
+		return ErrorCode::InvalidParameter;
+	}
+
+	// May already be gone if the reactor saw an error on it.
+	epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, source->pollFd(), nullptr);
+
+	// The caller's own handler, if it is one, is still on the stack and cannot finish first.
+	size_t own = t_dispatching == source ? 1 : 0;
+	m_handler_done.wait(lock, [this, source, own]
+						{
+		auto it = m_sources.find(source);
+		return it == m_sources.end() || it->second <= own; });
+	m_sources.erase(source);
+	return ErrorCode::Success;
+}
+
+size_t TransportReactor::size() const
+{
+	std::lock_guard<std::mutex> lock(m_sources_mutex);
+	return m_sources.size();
+}
+
+void TransportReactor::run()
+{
+	struct epoll_event events[MAX_EVENTS];
+
+	while (m_running.load(std::memory_order_acquire))
+	{
+		int count = epoll_wait(m_epoll_fd, events, MAX_EVENTS, -1);
+		if (count < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (events[i].data.ptr == nullptr)
+			{
+				return;
+			}
+
+			auto *source = static_cast<IPollable *>(events[i].data.ptr);
+			{
+				std::lock_guard<std::mutex> lock(m_sources_mutex);
+				auto it = m_sources.find(source);
+				if (it == m_sources.end())
+				{
+					continue;
+				}
+				++it->second;
+			}
+
+			bool keep = dispatch(source, events[i].events);
+
+			std::lock_guard<std::mutex> lock(m_sources_mutex);
+			auto it = m_sources.find(source);
+			if (it == m_sources.end())
+			{
+				// Removed by its own handler.
+				continue;
+			}
+			--it->second;
+			m_handler_done.notify_all();
+
+			// Re-armed under the lock so that a concurrent remove() cannot be undone.
+			if (keep && m_oneshot)
+			{
+				struct epoll_event rearm{};
+				rearm.events = EPOLLIN | EPOLLONESHOT;
+				rearm.data.ptr = source;
+				epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, source->pollFd(), &rearm);
+			}
+		}
+	}
+}
+
+bool TransportReactor::dispatch(IPollable *source, uint32_t events)
+{
+	t_dispatching = source;
+	bool keep = true;
+
+	if (events & EPOLLIN)
+	{
+		if (!source->onReadable())
+		{
+			epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, source->pollFd(), nullptr);
+			keep = false;
+		}
+	}
+	else if (events & (EPOLLERR | EPOLLHUP))
+	{
+		epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, source->pollFd(), nullptr);
+		source->onPollError();
+		keep = false;
+	}
+
+	t_dispatching = nullptr;
+	return keep;
+}
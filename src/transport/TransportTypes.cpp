@@ -1,7 +1,15 @@
 #include "transport/TransportTypes.hpp"
 
+#include <time.h>
+
 namespace wm::transport
 {
+    Timestamp monotonic_now()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<Timestamp>(now.tv_sec) * 1000000000ULL + static_cast<Timestamp>(now.tv_nsec);
+    }
 
     speed_t baudrate_to_speed_t(BaudRate baudrate)
     {
@@ -33,8 +41,18 @@ namespace wm::transport
             return B460800;
         case BaudRate::Baud921600:
             return B921600;
+        case BaudRate::Baud1000000:
+            return B1000000;
+        case BaudRate::Baud1500000:
+            return B1500000;
+        case BaudRate::Baud2000000:
+            return B2000000;
+        case BaudRate::Baud3000000:
+            return B3000000;
+        case BaudRate::Baud4000000:
+            return B4000000;
         default:
-            return B9600;
+            return B0;
         }
     }
     unsigned int data_bits_to_csize(DataBits data_bits)
@@ -1,12 +1,27 @@
 #include "transport/UartTransport.hpp"
+#include "transport/Termios2.hpp"
+#include "transport/ThreadPolicy.hpp"
+#include <climits>
+#include <fstream>
+#include <linux/serial.h>
 #include <iostream>
 #include <asm-generic/ioctls.h>
 #include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <sys/uio.h>
+#include <poll.h>
 #include <thread>
+#include <optional>
 
 using namespace wm::transport;
 
-UartTransport::UartTransport(const SerialConfig &config) : ITransport(config)
+UartTransport::UartTransport(const SerialConfig &config)
+	: ITransport(config),
+	  m_rx_queue(config.rx_queue_depth),
+	  m_rx_ring(std::max(config.rx_buffer_size, 2 * Framer::MAX_FRAME_SIZE)),
+	  m_framer(config.framing),
+	  m_tx_ring(std::max(config.tx_buffer_size, Framer::MAX_FRAME_SIZE))
 {
 }
 
@@ -24,7 +39,7 @@ ErrorCode UartTransport::open()
 
 	auto status = ErrorCode::Unknown;
 
-	status = configure_unix();
+	status = openDescriptor();
 
 	if (status != ErrorCode::Success)
 	{
@@ -32,109 +47,388 @@ ErrorCode UartTransport::open()
 		return status;
 	}
 
+	if (m_config.lock_memory)
+	{
+		lock_process_memory();
+	}
+
 	m_con_state = ConnectionState::Open;
 
+	status = startIo();
+	if (status != ErrorCode::Success)
+	{
+		close();
+		m_con_state = ConnectionState::Error;
+	}
+	return status;
+}
+
+ErrorCode UartTransport::startIo()
+{
+	if (m_reactor == nullptr)
+	{
+		auto status = setupEventLoop();
+		if (status != ErrorCode::Success)
+		{
+			return status;
+		}
+	}
+
 	try
 	{
+		this->startTransmitThread();
+		if (m_reactor != nullptr)
+		{
+			m_rx_ring.clear();
+			return m_reactor->add(this);
+		}
+
+		this->startDispatchThread();
 		this->startReceiveThread();
 	}
 	catch (const std::exception &ex)
 	{
 		std::cout << ex.what() << std::endl;
+		return ErrorCode::OperationFailed;
 	}
-	return status;
+	return ErrorCode::Success;
 }
 
-void UartTransport::receiveThread()
+void UartTransport::stopIo()
 {
-	int bytes_count = 0;
-	std::cout << "Starting main receive thread" << std::endl;
-	while (is_open())
+	stopTransmitThread();
+	if (m_reactor != nullptr)
+	{
+		m_reactor->remove(this);
+	}
+	else
+	{
+		stopReceiveThread();
+		stopDispatchThread();
+	}
+	teardownEventLoop();
+}
+
+void UartTransport::useReactor(TransportReactor *reactor)
+{
+	if (m_fd >= 0)
+	{
+		throw PortException("Cannot change reactor while port is open", ErrorCode::PortAlreadyOpen);
+	}
+
+	m_reactor = reactor;
+}
+
+bool UartTransport::onReadable()
+{
+	auto now = std::chrono::steady_clock::now();
+	if (!m_rx_ring.empty() && now - m_last_rx > std::chrono::milliseconds(m_config.read_timeout_ms))
+	{
+		std::cout << "Timeout waiting for data, dropping " << m_rx_ring.size() << " buffered bytes" << std::endl;
+		m_rx_ring.clear();
+	}
+
+	ssize_t bytes_read = readIntoRing();
+	if (bytes_read < 0)
+	{
+		std::cout << "Failed to read from port, stopping reception" << std::endl;
+		m_con_state = ConnectionState::Error;
+		return false;
+	}
+	m_last_rx = now;
+
+	extractFrames(static_cast<size_t>(bytes_read), monotonic_now());
+	return true;
+}
+
+void UartTransport::onPollError()
+{
+	std::cout << "Port error or hangup, stopping reception" << std::endl;
+	m_con_state = ConnectionState::Error;
+}
+
+ErrorCode UartTransport::setupEventLoop()
+{
+	m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (m_epoll_fd < 0 || m_wake_fd < 0)
+	{
+		teardownEventLoop();
+		return ErrorCode::OperationFailed;
+	}
+
+	struct epoll_event port_event{};
+	port_event.events = EPOLLIN;
+	port_event.data.fd = m_fd;
+
+	struct epoll_event wake_event{};
+	wake_event.events = EPOLLIN;
+	wake_event.data.fd = m_wake_fd;
+
+	if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_fd, &port_event) != 0 ||
+		epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wake_fd, &wake_event) != 0)
+	{
+		teardownEventLoop();
+		return ErrorCode::OperationFailed;
+	}
+
+	return ErrorCode::Success;
+}
+
+void UartTransport::teardownEventLoop()
+{
+	if (m_epoll_fd >= 0)
+	{
+		::close(m_epoll_fd);
+		m_epoll_fd = -1;
+	}
+
+	if (m_wake_fd >= 0)
+	{
+		::close(m_wake_fd);
+		m_wake_fd = -1;
+	}
+}
+
+UartTransport::PollResult UartTransport::waitForEvent(int timeout_ms)
+{
+	struct epoll_event events[2];
+
+	int count;
+	do
 	{
-		bytes_count = this->available();
-		if (bytes_count <= 0)
+		count = epoll_wait(m_epoll_fd, events, 2, timeout_ms);
+	} while (count < 0 && errno == EINTR);
+
+	if (count < 0)
+	{
+		return PollResult::Error;
+	}
+	if (count == 0)
+	{
+		return PollResult::Timeout;
+	}
+
+	auto result = PollResult::Timeout;
+	for (int i = 0; i < count; ++i)
+	{
+		if (events[i].data.fd == m_wake_fd)
 		{
-			continue;
+			return PollResult::Shutdown;
 		}
 
-		size_t bytes_read = this->receive(rx_buff, 1);
-		if (bytes_read != 1)
+		if (events[i].events & EPOLLIN)
 		{
-			std::cout << "Failed to read length byte" << std::endl;
-			continue;
+			result = PollResult::Readable;
 		}
-
-		uint8_t expected_len = rx_buff[0];
-		if (expected_len == 0 || expected_len > (RX_BUFF_SIZE - 1))
+		else if (events[i].events & (EPOLLERR | EPOLLHUP))
 		{
-			std::cout << "Invalid length: " << static_cast<int>(expected_len) << std::endl;
-			continue;
+			result = PollResult::Error;
 		}
+	}
 
-		auto start_time = std::chrono::steady_clock::now();
-		while (this->available() < expected_len)
+	return result;
+}
+
+ssize_t UartTransport::readIntoRing()
+{
+	auto segments = m_rx_ring.writable();
+	struct iovec iov[2];
+	int iov_count = 0;
+
+	for (auto segment : segments)
+	{
+		if (!segment.empty())
 		{
-			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+			iov[iov_count].iov_base = segment.data();
+			iov[iov_count].iov_len = segment.size();
+			++iov_count;
+		}
+	}
+
+	if (iov_count == 0)
+	{
+		return 0;
+	}
 
-			if (elapsed > 1000)
+	ssize_t bytes_read = ::readv(m_fd, iov, iov_count);
+	if (bytes_read > 0)
+	{
+		m_rx_ring.commit(static_cast<size_t>(bytes_read));
+	}
+	else if (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+	{
+		return 0;
+	}
+	else if (bytes_read == 0)
+	{
+		// Readable with nothing to read means the other end has gone away.
+		errno = ECONNRESET;
+		return -1;
+	}
+
+	return bytes_read;
+}
+
+size_t UartTransport::extractFrames(size_t bytes_read, Timestamp read_time)
+{
+	// Only the first frame of a pass can start in bytes that were already buffered.
+	bool had_leftover = m_rx_ring.size() > bytes_read;
+	Timestamp first_byte = had_leftover ? m_rx_partial_since : read_time;
+
+	size_t frames = m_framer.extract(m_rx_ring, [this, &first_byte, read_time](const char *frame, size_t length)
+									 {
+		handleFrame(frame, length, first_byte);
+		first_byte = read_time; });
+
+	if (frames > 0 || !had_leftover)
+	{
+		m_rx_partial_since = read_time;
+	}
+	return frames;
+}
+
+void UartTransport::handleFrame(const char *frame, size_t length, Timestamp received)
+{
+	try
+	{
+		decodeFrame(std::span<const char>(frame, length), received, [this](const MessageView &mes)
+					{
+			if (m_reactor != nullptr)
 			{
-				std::cout << "Timeout waiting for data. Expected: " << static_cast<int>(expected_len) << ", Available: " << this->available() << std::endl;
-				break;
+				notifyReceive(mes);
 			}
+			else if (!m_rx_queue.tryPush(mes.toOwned()))
+			{
+				m_rx_overflows.fetch_add(1, std::memory_order_relaxed);
+			} });
+	}
+	catch (const std::exception &ex)
+	{
+		std::cout << "Exception: " << ex.what() << std::endl;
+	}
+}
 
-			usleep(thread_timeout * 10);
-		}
+void UartTransport::receiveThread()
+{
+	std::cout << "Starting main receive thread" << std::endl;
+	apply_thread_policy(m_config.rx_thread, "uart-rx");
+	while (is_open())
+	{
+		// A pending partial frame is discarded if the rest does not arrive in time.
+		int timeout_ms = m_rx_ring.empty() ? -1 : static_cast<int>(m_config.read_timeout_ms);
 
-		bytes_read = this->receive(rx_buff + 1, expected_len);
-		if (bytes_read != expected_len)
+		auto event = waitForEvent(timeout_ms);
+		if (event == PollResult::Shutdown)
+		{
+			break;
+		}
+		if (event == PollResult::Error)
+		{
+			std::cout << "Port error or hangup, stopping receive thread" << std::endl;
+			m_con_state = ConnectionState::Error;
+			break;
+		}
+		if (event == PollResult::Timeout)
 		{
-			std::cout << "Failed to read complete message. Expected: " << static_cast<int>(expected_len) << ", Got: " << bytes_read << std::endl;
+			if (!m_rx_ring.empty())
+			{
+				std::cout << "Timeout waiting for data, dropping " << m_rx_ring.size() << " buffered bytes" << std::endl;
+				m_rx_ring.clear();
+			}
 			continue;
 		}
 
-		size_t total_bytes = 1 + expected_len;
-
-		try
+		ssize_t bytes_read = readIntoRing();
+		if (bytes_read < 0)
 		{
-			Message mes = Message::deserialize(rx_buff, total_bytes);
-			mes.print();
-			std::unique_lock<std::mutex> queueLock(mtxReceive);
-
-			notifyReceive(mes);
-
-			queueLock.unlock();
+			std::cout << "Failed to read from port, stopping receive thread" << std::endl;
+			m_con_state = ConnectionState::Error;
+			break;
 		}
-		catch (const std::exception &ex)
+
+		size_t frames = extractFrames(static_cast<size_t>(bytes_read), monotonic_now());
+		if (frames > 0)
 		{
-			std::cout << "Exception: " << ex.what() << std::endl;
+			m_rx_queue.notifyConsumer();
 		}
-		memset(rx_buff, 0, RX_BUFF_SIZE);
 	};
 };
 
-ErrorCode UartTransport::close()
+void UartTransport::startDispatchThread()
 {
-	if (!is_open())
+	m_dispatch_stop.store(false, std::memory_order_release);
+	m_dispatch_thread = std::thread(&UartTransport::dispatchThread, this);
+}
+
+void UartTransport::stopDispatchThread()
+{
+	m_dispatch_stop.store(true, std::memory_order_release);
+	m_rx_queue.wake();
+
+	release_thread(m_dispatch_thread);
+}
+
+void UartTransport::dispatchThread()
+{
+	apply_thread_policy(m_config.dispatch_thread, "uart-dispatch");
+	while (!m_dispatch_stop.load(std::memory_order_acquire))
 	{
-		return ErrorCode::Success;
+		if (!m_rx_queue.waitForData(std::chrono::milliseconds(m_config.read_timeout_ms)))
+		{
+			continue;
+		}
+
+		m_rx_queue.popBatch([this](const Message &mes)
+							{
+			try
+			{
+				notifyReceive(mes.view());
+			}
+			catch (const std::exception &ex)
+			{
+				std::cout << "Exception in receive callback: " << ex.what() << std::endl;
+			} }, RX_DISPATCH_BATCH);
 	}
 
-	if (m_fd >= 0)
+	// Discarded here rather than in stopDispatchThread() because only this thread may consume.
+	while (m_rx_queue.popBatch([](const Message &) {}, m_rx_queue.capacity()) > 0)
 	{
-		::close(m_fd);
-		m_fd = -1;
+	}
+}
+
+void UartTransport::stopReceiveThread()
+{
+	if (m_wake_fd >= 0)
+	{
+		uint64_t signal = 1;
+		ssize_t written = ::write(m_wake_fd, &signal, sizeof(signal));
+		(void)written;
+	}
+
+	release_thread(m_thread);
+}
+
+ErrorCode UartTransport::close()
+{
+	if (m_fd < 0)
+	{
+		return ErrorCode::Success;
 	}
 
 	m_con_state = ConnectionState::Closed;
+	stopIo();
+
+	::close(m_fd);
+	m_fd = -1;
+
 	return ErrorCode::Success;
 }
 
 int UartTransport::sendMessage(const Message *mes)
 {
-	auto serialized = mes->serialize();
-
-	int status = this->send(serialized.data(), serialized.size());
-	return status;
+	return this->sendInPlace(mes->serializedSize(), [mes](std::span<char> out)
+							 { return mes->serializeInto(out); });
 }
 
 int UartTransport::send(const char *data, size_t length)
@@ -149,15 +443,363 @@ int UartTransport::send(const char *data, size_t length)
 		return 0;
 	}
 
-	std::cout << "Sending: " << length << " bytes" << std::endl;
+	enqueueTransmit(data, length, nullptr);
+	return static_cast<int>(length);
+}
+
+ErrorCode UartTransport::trySend(const char *data, size_t length)
+{
+	if (!is_open())
+	{
+		return ErrorCode::PortNotOpen;
+	}
+	if (data == nullptr || length == 0)
+	{
+		return ErrorCode::Success;
+	}
+
+	size_t wire_max = m_framer.maxWireSize(length);
+	if (!m_framer.accepts(length) || wire_max > m_tx_ring.capacity())
+	{
+		return ErrorCode::InvalidParameter;
+	}
+
+	std::unique_lock<std::mutex> lock(mtxTransmit);
+	if (m_tx_stop)
+	{
+		return ErrorCode::PortNotOpen;
+	}
+	if (m_tx_ring.space() < wire_max)
+	{
+		return ErrorCode::BufferOverflow;
+	}
+
+	size_t wire_length = m_framer.writeFrame(data, length, [this](const char *bytes, size_t count)
+											 { m_tx_ring.write(bytes, count); });
+	commitTransmit(lock, wire_length, length, nullptr);
+	return ErrorCode::Success;
+}
+
+size_t UartTransport::pendingTransmitBytes() const
+{
+	size_t queued;
+	{
+		std::lock_guard<std::mutex> lock(mtxTransmit);
+		queued = m_tx_ring.size();
+	}
+
+	int in_driver = 0;
+	if (m_fd >= 0 && ioctl(m_fd, TIOCOUTQ, &in_driver) == 0 && in_driver > 0)
+	{
+		queued += static_cast<size_t>(in_driver);
+	}
+	return queued;
+}
+
+void UartTransport::sendAsync(const char *data, size_t length, SendCallback on_complete)
+{
+	if (!is_open())
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+
+	if (data == nullptr || length == 0)
+	{
+		if (on_complete)
+		{
+			on_complete(0);
+		}
+		return;
+	}
+
+	enqueueTransmit(data, length, std::move(on_complete));
+}
+
+int UartTransport::sendInPlace(size_t max_length, const FrameWriter &writer)
+{
+	if (!is_open())
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+
+	size_t wire_max = m_framer.maxWireSize(max_length);
+	if (!m_framer.accepts(max_length) || wire_max > TX_BUFF_SIZE)
+	{
+		return ITransport::sendInPlace(max_length, writer);
+	}
+
+	auto lock = waitTransmitSpace(wire_max);
+
+	// The frame is written behind room for its header, which needs the frame's bytes,
+	// and finished in place once they are there.
+	auto tail = m_tx_ring.writable()[0];
+	char *frame = tail.size() >= wire_max ? tail.data() : tx_buff;
+	size_t length = writer(std::span<char>(frame + m_framer.headerSize(), max_length));
+	size_t wire_length = length == 0 ? 0 : m_framer.finish(frame, length);
+
+	if (frame == tx_buff)
+	{
+		m_tx_ring.write(tx_buff, wire_length);
+	}
+	else
+	{
+		m_tx_ring.commit(wire_length);
+	}
+
+	commitTransmit(lock, wire_length, length, nullptr);
+	return static_cast<int>(length);
+}
+
+void UartTransport::enqueueTransmit(const char *data, size_t length, SendCallback on_complete)
+{
+	if (!m_framer.accepts(length))
+	{
+		throw PortException("Frame too long for the framing mode", ErrorCode::InvalidParameter);
+	}
+
+	auto lock = waitTransmitSpace(m_framer.maxWireSize(length));
+
+	size_t wire_length = m_framer.writeFrame(data, length, [this](const char *bytes, size_t count)
+											 { m_tx_ring.write(bytes, count); });
+	commitTransmit(lock, wire_length, length, std::move(on_complete));
+}
+
+std::unique_lock<std::mutex> UartTransport::waitTransmitSpace(size_t length)
+{
+	if (length > m_tx_ring.capacity())
+	{
+		throw PortException("Data exceeds transmit buffer size", ErrorCode::BufferOverflow);
+	}
+
+	std::unique_lock<std::mutex> lock(mtxTransmit);
+
+	bool has_space = m_tx_space_cv.wait_for(lock, std::chrono::milliseconds(m_config.write_timeout_ms), [&]
+											{ return m_tx_ring.space() >= length || m_tx_stop; });
+	if (m_tx_stop)
+	{
+		throw PortException("Port not open", ErrorCode::PortNotOpen);
+	}
+	if (!has_space)
+	{
+		throw TimeoutException("Transmit queue full");
+	}
+
+	return lock;
+}
+
+void UartTransport::commitTransmit(std::unique_lock<std::mutex> &lock, size_t wire_length, size_t length, SendCallback on_complete)
+{
+	m_tx_queued_total += wire_length;
+
+	if (on_complete || m_timing_hook)
+	{
+		Timestamp queued = m_timing_hook ? monotonic_now() : 0;
+		m_tx_pending.push_back({m_tx_queued_total, static_cast<int>(length), std::move(on_complete), queued});
+	}
+
+	lock.unlock();
+	onTransmitQueued();
+}
+
+void UartTransport::startTransmitThread()
+{
+	m_tx_stop = false;
+	m_tx_thread = std::thread(&UartTransport::transmitThread, this);
+}
 
-	ssize_t bytes_written = ::write(m_fd, data, length);
-	if (bytes_written < 0)
+void UartTransport::stopTransmitThread()
+{
 	{
-		throw PortException("Failed to write to port", ErrorCode::OperationFailed);
+		std::lock_guard<std::mutex> lock(mtxTransmit);
+		m_tx_stop = true;
 	}
-	std::cout << "Written bytes: " << bytes_written << std::endl;
-	return bytes_written;
+	m_tx_data_cv.notify_all();
+	m_tx_space_cv.notify_all();
+
+	release_thread(m_tx_thread);
+}
+
+void UartTransport::transmitThread()
+{
+	using clock = std::chrono::steady_clock;
+	const auto write_timeout = std::chrono::milliseconds(m_config.write_timeout_ms);
+	std::optional<clock::time_point> stalled_since;
+	apply_thread_policy(m_config.tx_thread, "uart-tx");
+
+	while (true)
+	{
+		struct iovec iov[2];
+		int iov_count = 0;
+		{
+			std::unique_lock<std::mutex> lock(mtxTransmit);
+			auto has_work = [this]
+			{ return !m_tx_ring.empty() || m_tx_stop; };
+			if (m_tx_draining.empty())
+			{
+				m_tx_data_cv.wait(lock, has_work);
+			}
+			else if (!m_tx_data_cv.wait_for(lock, DRAIN_POLL_INTERVAL, has_work))
+			{
+				// Nothing to write, but written frames are still waiting in the driver.
+				lock.unlock();
+				reportDrained(false);
+				continue;
+			}
+
+			if (m_tx_ring.empty())
+			{
+				break;
+			}
+			iov_count = transmitSegments(iov);
+		}
+
+		// Producers only append to the free part of the ring, so the queued bytes can be written unlocked.
+		ssize_t written = writeSegments(iov, iov_count);
+		bool would_block = written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+		bool stalled = false;
+		if (would_block)
+		{
+			// The driver's output queue is full; give up once it has not drained for write_timeout_ms.
+			auto now = clock::now();
+			if (!stalled_since)
+			{
+				stalled_since = now;
+			}
+			auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(*stalled_since + write_timeout - now);
+			stalled = remaining.count() <= 0;
+			if (!stalled)
+			{
+				struct pollfd pfd{m_fd, POLLOUT, 0};
+				::poll(&pfd, 1, static_cast<int>(std::min<int64_t>(remaining.count(), 100)));
+			}
+			else
+			{
+				std::cout << "Port accepted no data for " << m_config.write_timeout_ms << " ms" << std::endl;
+			}
+		}
+		else
+		{
+			stalled_since.reset();
+		}
+
+		// Stopping does not cut this short: close() still waits up to write_timeout_ms for the port.
+		bool failed = (written < 0 && !would_block) || (would_block && stalled);
+		if (failed)
+		{
+			stalled_since.reset();
+		}
+		finishTransmit(written > 0 ? static_cast<size_t>(written) : 0, failed);
+	}
+
+	reportDrained(true);
+}
+
+int UartTransport::transmitSegments(struct iovec *iov)
+{
+	int iov_count = 0;
+	for (auto segment : m_tx_ring.readableSegments())
+	{
+		if (!segment.empty())
+		{
+			iov[iov_count].iov_base = const_cast<char *>(segment.data());
+			iov[iov_count].iov_len = segment.size();
+			++iov_count;
+		}
+	}
+	return iov_count;
+}
+
+void UartTransport::finishTransmit(size_t written, bool failed)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxTransmit);
+
+		size_t consumed = written;
+		if (failed)
+		{
+			std::cout << "Failed to write to port, dropping " << m_tx_ring.size() << " queued bytes" << std::endl;
+			consumed = m_tx_ring.size();
+		}
+
+		m_tx_ring.consume(consumed);
+		m_tx_written_total += consumed;
+
+		Timestamp written_at = 0;
+		while (!m_tx_pending.empty() && m_tx_pending.front().end_offset <= m_tx_written_total)
+		{
+			auto &pending = m_tx_pending.front();
+			if (pending.on_complete)
+			{
+				m_tx_completed.emplace_back(std::move(pending.on_complete), failed ? -1 : pending.length);
+			}
+			if (m_timing_hook && !failed)
+			{
+				if (written_at == 0)
+				{
+					written_at = monotonic_now();
+				}
+
+				FrameTiming timing;
+				timing.direction = FrameDirection::Tx;
+				timing.length = static_cast<size_t>(pending.length);
+				timing.queued = pending.queued;
+				timing.written = written_at;
+				m_tx_draining.emplace_back(pending.end_offset, timing);
+			}
+			m_tx_pending.pop_front();
+		}
+
+		if (consumed == 0 && m_tx_completed.empty())
+		{
+			return;
+		}
+	}
+
+	m_tx_space_cv.notify_all();
+
+	for (auto &[on_complete, result] : m_tx_completed)
+	{
+		on_complete(result);
+	}
+	m_tx_completed.clear();
+
+	reportDrained(false);
+}
+
+bool UartTransport::reportDrained(bool flush)
+{
+	if (m_tx_draining.empty())
+	{
+		return false;
+	}
+
+	int in_driver = 0;
+	if (ioctl(m_fd, TIOCOUTQ, &in_driver) != 0 || in_driver < 0)
+	{
+		in_driver = 0;
+	}
+
+	// Bytes beyond this offset are still in the driver; m_tx_written_total only changes on this thread.
+	uint64_t on_wire = m_tx_written_total - std::min<uint64_t>(static_cast<uint64_t>(in_driver), m_tx_written_total);
+	Timestamp now = monotonic_now();
+
+	while (!m_tx_draining.empty() && (flush || m_tx_draining.front().first <= on_wire))
+	{
+		auto &[end_offset, timing] = m_tx_draining.front();
+		if (end_offset <= on_wire)
+		{
+			timing.drained = now;
+		}
+		m_timing_hook(timing);
+		m_tx_draining.pop_front();
+	}
+
+	return !m_tx_draining.empty();
+}
+
+void UartTransport::onTransmitQueued()
+{
+	m_tx_data_cv.notify_one();
 }
 
 int UartTransport::receive(char *buffer, size_t length)
@@ -179,6 +821,16 @@ int UartTransport::available() const
 	return bytes;
 }
 
+ErrorCode UartTransport::openDescriptor()
+{
+	return configure_unix();
+}
+
+ssize_t UartTransport::writeSegments(const struct iovec *iov, int iov_count)
+{
+	return ::writev(m_fd, iov, iov_count);
+}
+
 ErrorCode UartTransport::configure_unix()
 {
 	struct termios options;
@@ -196,10 +848,13 @@ ErrorCode UartTransport::configure_unix()
 		return ErrorCode::InvalidParameter;
 	}
 
+	// Rates without a Bxxx constant are applied through termios2 once the rest is set.
 	speed_t speed = baudrate_to_speed_t(m_config.baudrate);
-
-	cfsetospeed(&options, speed);
-	cfsetispeed(&options, speed);
+	if (speed != B0)
+	{
+		cfsetospeed(&options, speed);
+		cfsetispeed(&options, speed);
+	}
 
 	options.c_cflag |= (data_bits_to_csize(m_config.databits) | CREAD | CLOCAL);
 
@@ -209,8 +864,10 @@ ErrorCode UartTransport::configure_unix()
 	options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
 	options.c_oflag &= ~OPOST;
 
+	// Both backends wait for readiness and then read whatever is buffered without
+	// blocking, which bypasses VMIN/VTIME; latency is tuned in applyLatencyProfile().
 	options.c_cc[VMIN] = 0;
-	options.c_cc[VTIME] = 100;
+	options.c_cc[VTIME] = 0;
 
 	if (tcsetattr(m_fd, TCSANOW, &options) != 0)
 	{
@@ -219,5 +876,57 @@ ErrorCode UartTransport::configure_unix()
 		return ErrorCode::InvalidParameter;
 	}
 
+	applyLatencyProfile();
+
+	uint32_t requested = static_cast<uint32_t>(m_config.baudrate);
+	if (speed == B0 && !set_custom_baudrate(m_fd, requested))
+	{
+		std::cout << "Baud rate " << requested << " not supported by the port" << std::endl;
+		::close(m_fd);
+		m_fd = -1;
+		return ErrorCode::InvalidParameter;
+	}
+
+	m_actual_baudrate = get_actual_baudrate(m_fd);
+	if (m_actual_baudrate != 0 && m_actual_baudrate != requested)
+	{
+		std::cout << "Requested " << requested << " baud, port runs at " << m_actual_baudrate << std::endl;
+	}
+
 	return ErrorCode::Success;
 }
+
+void UartTransport::applyLatencyProfile()
+{
+	if (m_config.latency_profile == LatencyProfile::Balanced)
+	{
+		return;
+	}
+	bool low_latency = m_config.latency_profile == LatencyProfile::LowLatency;
+
+	// Not every driver implements TIOCSSERIAL (ptys, CDC-ACM); that is not an error.
+	struct serial_struct serial;
+	if (ioctl(m_fd, TIOCGSERIAL, &serial) == 0)
+	{
+		if (low_latency)
+			serial.flags |= ASYNC_LOW_LATENCY;
+		else
+			serial.flags &= ~ASYNC_LOW_LATENCY;
+		ioctl(m_fd, TIOCSSERIAL, &serial);
+	}
+
+	// USB-serial adapters (FTDI and friends) buffer received bytes for latency_timer ms.
+	char resolved[PATH_MAX];
+	if (realpath(m_config.port.c_str(), resolved) == nullptr)
+	{
+		return;
+	}
+	std::string device = resolved;
+	device = device.substr(device.find_last_of('/') + 1);
+
+	std::ofstream latency_timer("/sys/bus/usb-serial/devices/" + device + "/latency_timer");
+	if (latency_timer)
+	{
+		latency_timer << (low_latency ? 1 : 16);
+	}
+}
@@ -0,0 +1,503 @@
+#include "transport/UringTransport.hpp"
+#include "transport/ThreadPolicy.hpp"
+#include <algorithm>
+#include <iostream>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+using namespace wm::transport;
+
+UringTransport::UringTransport(const SerialConfig &config) : UartTransport(config)
+{
+}
+
+UringTransport::~UringTransport()
+{
+	// Closed here so that the overridden stopIo() still runs.
+	close();
+}
+
+ErrorCode UringTransport::startIo()
+{
+	if (m_reactor != nullptr)
+	{
+		return UartTransport::startIo();
+	}
+
+	try
+	{
+		m_ring = std::make_unique<IoUring>(RING_ENTRIES);
+	}
+	catch (const TransportException &ex)
+	{
+		std::cout << ex.what() << ", falling back to epoll" << std::endl;
+		return UartTransport::startIo();
+	}
+
+	auto storage = m_rx_ring.storage();
+	struct iovec fixed_buffer{storage.data(), storage.size()};
+	m_event_fd = eventfd(0, EFD_CLOEXEC);
+	if (m_event_fd < 0 || m_ring->registerBuffers(&fixed_buffer, 1) != ErrorCode::Success)
+	{
+		std::cout << "Failed to set up io_uring buffers, falling back to epoll" << std::endl;
+		if (m_event_fd >= 0)
+		{
+			::close(m_event_fd);
+			m_event_fd = -1;
+		}
+		m_ring.reset();
+		return UartTransport::startIo();
+	}
+
+	// The port stays non-blocking: reads and writes wait for readiness in a poll
+	// request, which can be cancelled, rather than blocking an io-wq worker.
+	m_rx_ring.clear();
+	m_read_poll_posted = m_read_posted = m_write_poll_posted = m_write_posted = false;
+	m_wake_posted = m_timeout_posted = m_drain_posted = false;
+	m_write_timeouts_posted = 0;
+	m_cancels_posted = 0;
+	m_write_stalled_since.reset();
+	m_tx_stop = false;
+	m_ring_stop = false;
+
+	try
+	{
+		startDispatchThread();
+		m_ring_thread = std::thread(&UringTransport::ringThread, this);
+	}
+	catch (const std::exception &ex)
+	{
+		std::cout << ex.what() << std::endl;
+		return ErrorCode::OperationFailed;
+	}
+	return ErrorCode::Success;
+}
+
+void UringTransport::stopIo()
+{
+	if (m_ring == nullptr)
+	{
+		UartTransport::stopIo();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mtxTransmit);
+		m_tx_stop = true;
+	}
+	m_ring_stop = true;
+	m_tx_space_cv.notify_all();
+
+	uint64_t signal = 1;
+	ssize_t written = ::write(m_event_fd, &signal, sizeof(signal));
+	(void)written;
+
+	bool on_ring_thread = m_ring_thread.get_id() == std::this_thread::get_id();
+	release_thread(m_ring_thread);
+	stopDispatchThread();
+
+	if (on_ring_thread)
+	{
+		// Closed from a send completion: the ring is still in use further up this stack.
+		m_release_on_exit = true;
+		return;
+	}
+	releaseRing();
+}
+
+void UringTransport::releaseRing()
+{
+	m_ring.reset();
+	::close(m_event_fd);
+	m_event_fd = -1;
+}
+
+void UringTransport::onTransmitQueued()
+{
+	if (!usingIoUring())
+	{
+		UartTransport::onTransmitQueued();
+		return;
+	}
+
+	// Pairs with the store in ringThread(): either the ring thread sees the new data
+	// before it sleeps, or it is already marked idle here and gets woken.
+	if (m_ring_idle.load(std::memory_order_seq_cst))
+	{
+		uint64_t signal = 1;
+		ssize_t written = ::write(m_event_fd, &signal, sizeof(signal));
+		(void)written;
+	}
+}
+
+void UringTransport::ringThread()
+{
+	std::cout << "Starting io_uring thread" << std::endl;
+	apply_thread_policy(m_config.rx_thread, "uart-uring");
+	postRead();
+	postWake();
+	bool failed = false;
+
+	while (true)
+	{
+		m_ring_idle.store(true, std::memory_order_seq_cst);
+		{
+			std::lock_guard<std::mutex> lock(mtxTransmit);
+			if (!m_write_posted && !m_write_poll_posted)
+			{
+				postWrite();
+			}
+		}
+
+		if (m_write_posted || m_write_poll_posted)
+		{
+			// Also while stopping: the linked timeouts bound the flush to write_timeout_ms.
+			m_ring_idle.store(false, std::memory_order_relaxed);
+		}
+		else if (!m_tx_draining.empty() && !m_drain_posted && !m_ring_stop)
+		{
+			postDrainPoll();
+		}
+		else if (m_ring_stop)
+		{
+			break;
+		}
+
+		int result = m_ring->submitAndWait(1);
+		m_ring_idle.store(false, std::memory_order_relaxed);
+		if (result < 0 && result != -EINTR && result != -EBUSY)
+		{
+			std::cout << "io_uring_enter failed, stopping io_uring thread" << std::endl;
+			m_con_state = ConnectionState::Error;
+			{
+				std::lock_guard<std::mutex> lock(mtxTransmit);
+				m_tx_stop = true;
+			}
+			m_tx_space_cv.notify_all();
+			m_ring_stop = true;
+			failed = true;
+			break;
+		}
+
+		m_ring->forEachCompletion([this](const struct io_uring_cqe &cqe)
+								  { onCompletion(cqe); });
+	}
+
+	// Cancel everything still in flight and wait until the kernel is done with our buffers.
+	for (Op op : {OpReadPoll, OpRead, OpWritePoll, OpWrite, OpWake, OpTimeout, OpDrain})
+	{
+		postCancel(op);
+	}
+
+	while (anyPosted())
+	{
+		int result = m_ring->submitAndWait(1);
+		if (result < 0 && result != -EINTR && result != -EBUSY)
+		{
+			break;
+		}
+		m_ring->forEachCompletion([this](const struct io_uring_cqe &cqe)
+								  { onCompletion(cqe); });
+	}
+
+	if (failed)
+	{
+		finishTransmit(0, true);
+	}
+	reportDrained(true);
+
+	if (m_release_on_exit)
+	{
+		m_release_on_exit = false;
+		releaseRing();
+	}
+}
+
+bool UringTransport::anyPosted() const
+{
+	return m_read_poll_posted || m_read_posted || m_write_poll_posted || m_write_timeouts_posted > 0 ||
+		   m_write_posted || m_wake_posted || m_timeout_posted || m_drain_posted;
+}
+
+void UringTransport::onCompletion(const struct io_uring_cqe &cqe)
+{
+	switch (cqe.user_data)
+	{
+	case OpReadPoll:
+		m_read_poll_posted = false;
+		if (cqe.res < 0 && cqe.res != -ECANCELED)
+		{
+			std::cout << "Failed to poll port, stopping reception" << std::endl;
+			m_con_state = ConnectionState::Error;
+		}
+		break;
+
+	case OpRead:
+		m_read_posted = false;
+		if (cqe.res > 0)
+		{
+			m_rx_ring.commit(static_cast<size_t>(cqe.res));
+			++m_read_count;
+
+			size_t frames = extractFrames(static_cast<size_t>(cqe.res), monotonic_now());
+			if (frames > 0)
+			{
+				m_rx_queue.notifyConsumer();
+			}
+			if (!m_rx_ring.empty() && !m_timeout_posted && !m_ring_stop)
+			{
+				postPartialFrameTimeout();
+			}
+		}
+		else if (cqe.res != -EINTR && cqe.res != -EAGAIN && cqe.res != -ECANCELED)
+		{
+			std::cout << "Port error or hangup, stopping reception" << std::endl;
+			m_con_state = ConnectionState::Error;
+			break;
+		}
+
+		if (!m_ring_stop && m_con_state != ConnectionState::Error)
+		{
+			postRead();
+		}
+		break;
+
+	case OpWrite:
+		m_write_posted = false;
+		if (cqe.res > 0)
+		{
+			m_write_stalled_since.reset();
+			finishTransmit(static_cast<size_t>(cqe.res), false);
+		}
+		else if (cqe.res == -EAGAIN || cqe.res == -EINTR || cqe.res == -ECANCELED || cqe.res == 0)
+		{
+			onWriteBlocked();
+		}
+		else
+		{
+			m_write_stalled_since.reset();
+			finishTransmit(0, true);
+		}
+		break;
+
+	case OpWritePoll:
+		m_write_poll_posted = false;
+		if (cqe.res == -ECANCELED)
+		{
+			onWriteBlocked();
+		}
+		break;
+
+	case OpWriteTimeout:
+		--m_write_timeouts_posted;
+		break;
+
+	case OpCancel:
+		--m_cancels_posted;
+		break;
+
+	case OpWake:
+		m_wake_posted = false;
+		if (!m_ring_stop)
+		{
+			postWake();
+		}
+		break;
+
+	case OpTimeout:
+		m_timeout_posted = false;
+		if (cqe.res == -ETIME && m_read_count == m_timeout_read_count && !m_rx_ring.empty())
+		{
+			std::cout << "Timeout waiting for data, dropping " << m_rx_ring.size() << " buffered bytes" << std::endl;
+			m_rx_ring.clear();
+		}
+		if (!m_rx_ring.empty() && !m_ring_stop)
+		{
+			postPartialFrameTimeout();
+		}
+		break;
+
+	case OpDrain:
+		m_drain_posted = false;
+		reportDrained(false);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UringTransport::postRead()
+{
+	// The framer leaves at most one partial frame behind, so the tail segment is never empty.
+	auto segment = m_rx_ring.writable()[0];
+
+	// The read is linked behind a poll so that it only runs once there is data.
+	auto *poll = nextSqe();
+	poll->opcode = IORING_OP_POLL_ADD;
+	poll->fd = m_fd;
+	poll->poll32_events = POLLIN;
+	poll->flags = IOSQE_IO_LINK;
+	poll->user_data = OpReadPoll;
+	m_read_poll_posted = true;
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_READ_FIXED;
+	sqe->fd = m_fd;
+	sqe->off = static_cast<uint64_t>(-1);
+	sqe->addr = reinterpret_cast<uint64_t>(segment.data());
+	sqe->len = static_cast<uint32_t>(segment.size());
+	sqe->buf_index = 0;
+	sqe->user_data = OpRead;
+	m_read_posted = true;
+}
+
+void UringTransport::postWrite()
+{
+	if (m_tx_ring.empty())
+	{
+		return;
+	}
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_WRITEV;
+	sqe->fd = m_fd;
+	sqe->off = static_cast<uint64_t>(-1);
+	sqe->addr = reinterpret_cast<uint64_t>(m_write_iov);
+	sqe->len = static_cast<uint32_t>(transmitSegments(m_write_iov));
+	sqe->flags = IOSQE_IO_LINK;
+	sqe->user_data = OpWrite;
+	m_write_posted = true;
+	m_write_posted_at = std::chrono::steady_clock::now();
+
+	// Drivers that support non-blocking I/O get a write to a full port parked in
+	// an internal poll rather than failed with -EAGAIN; the timeout bounds it.
+	postWriteTimeout();
+}
+
+void UringTransport::onWriteBlocked()
+{
+	// The driver's output queue is full; give up once it has not drained for write_timeout_ms.
+	if (!m_write_stalled_since)
+	{
+		m_write_stalled_since = m_write_posted_at;
+	}
+	if (writeStallRemaining() <= std::chrono::nanoseconds::zero())
+	{
+		std::cout << "Port accepted no data for " << m_config.write_timeout_ms << " ms" << std::endl;
+		m_write_stalled_since.reset();
+		finishTransmit(0, true);
+		return;
+	}
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = m_fd;
+	sqe->poll32_events = POLLOUT;
+	sqe->flags = IOSQE_IO_LINK;
+	sqe->user_data = OpWritePoll;
+	m_write_poll_posted = true;
+	postWriteTimeout();
+}
+
+std::chrono::nanoseconds UringTransport::writeStallRemaining() const
+{
+	auto now = std::chrono::steady_clock::now();
+	auto since = m_write_stalled_since.value_or(now);
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(since + std::chrono::milliseconds(m_config.write_timeout_ms) - now);
+}
+
+void UringTransport::postWriteTimeout()
+{
+	// The kernel copies the timeout when the request is prepared, so one buffer serves every write.
+	auto limit = std::max(writeStallRemaining(), std::chrono::nanoseconds(std::chrono::milliseconds(1)));
+	m_write_timeout.tv_sec = static_cast<long long>(limit.count() / 1000000000);
+	m_write_timeout.tv_nsec = static_cast<long long>(limit.count() % 1000000000);
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_LINK_TIMEOUT;
+	sqe->addr = reinterpret_cast<uint64_t>(&m_write_timeout);
+	sqe->len = 1;
+	sqe->user_data = OpWriteTimeout;
+	++m_write_timeouts_posted;
+}
+
+void UringTransport::postCancel(Op op)
+{
+	bool posted = op == OpReadPoll	  ? m_read_poll_posted
+				  : op == OpRead	  ? m_read_posted
+				  : op == OpWritePoll ? m_write_poll_posted
+				  : op == OpWrite	  ? m_write_posted
+				  : op == OpWake	  ? m_wake_posted
+				  : op == OpTimeout	  ? m_timeout_posted
+									  : m_drain_posted;
+	if (!posted)
+	{
+		return;
+	}
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->addr = op;
+	sqe->user_data = OpCancel;
+	++m_cancels_posted;
+}
+
+void UringTransport::postWake()
+{
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = m_event_fd;
+	sqe->addr = reinterpret_cast<uint64_t>(&m_event_value);
+	sqe->len = sizeof(m_event_value);
+	sqe->user_data = OpWake;
+	m_wake_posted = true;
+}
+
+void UringTransport::postPartialFrameTimeout()
+{
+	m_partial_timeout.tv_sec = m_config.read_timeout_ms / 1000;
+	m_partial_timeout.tv_nsec = static_cast<long long>(m_config.read_timeout_ms % 1000) * 1000000;
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_TIMEOUT;
+	sqe->addr = reinterpret_cast<uint64_t>(&m_partial_timeout);
+	sqe->len = 1;
+	sqe->user_data = OpTimeout;
+	m_timeout_posted = true;
+	m_timeout_read_count = m_read_count;
+}
+
+void UringTransport::postDrainPoll()
+{
+	auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(DRAIN_POLL_INTERVAL);
+	m_drain_timeout.tv_sec = 0;
+	m_drain_timeout.tv_nsec = static_cast<long long>(interval.count());
+
+	auto *sqe = nextSqe();
+	sqe->opcode = IORING_OP_TIMEOUT;
+	sqe->addr = reinterpret_cast<uint64_t>(&m_drain_timeout);
+	sqe->len = 1;
+	sqe->user_data = OpDrain;
+	m_drain_posted = true;
+}
+
+struct io_uring_sqe *UringTransport::nextSqe()
+{
+	auto *sqe = m_ring->getSqe();
+	if (sqe == nullptr)
+	{
+		m_ring->submitAndWait(0);
+		sqe = m_ring->getSqe();
+	}
+	return sqe;
+}
+
+std::unique_ptr<UartTransport> wm::transport::createSerialTransport(const SerialConfig &config)
+{
+	if (config.io_backend == IoBackend::IoUring && IoUring::isSupported())
+	{
+		return std::make_unique<UringTransport>(config);
+	}
+	return std::make_unique<UartTransport>(config);
+}